@@ -33,8 +33,12 @@ Resources getArmyDeploymentCost(ArmyType armyType) {
   }
 }
 
+MovementClass getMovementClass(ArmyType armyType) {
+  return armyType == ArmyType::MARINE ? AMPHIBIOUS : LAND;
+}
+
 Army::Army(ArmyType type, std::pair<int, int> location,
-           std::shared_ptr<Player> owner, int unitCount)
+           PlayerIndex owner, int unitCount)
     : Selectable(getArmyTypeName(type)),
       owner_(owner),
       location_(location),
@@ -45,26 +49,30 @@ Army::Army(ArmyType type, std::pair<int, int> location,
     case ArmyType::INFANTRY:
       attack_ = 2;
       defense_ = 2;
+      speed_ = 1;
       break;
     case ArmyType::CAVALRY:
       attack_ = 3;
       defense_ = 3;
+      speed_ = 2;
       break;
     case ArmyType::ARTILLERY:
       attack_ = 100;
       defense_ = 100;
+      speed_ = 1;
       break;
     case ArmyType::MARINE:
       attack_ = 2;
       defense_ = 2;
+      speed_ = 2;
       break;
   }
 }
 
-std::shared_ptr<Player> Army::getOwner() const { return owner_; };
+PlayerIndex Army::getOwner() const { return owner_; };
 
-std::shared_ptr<Player> Army::setOwner(std::shared_ptr<Player> player) {
-  std::shared_ptr<Player> currentOwner = owner_;
+PlayerIndex Army::setOwner(PlayerIndex player) {
+  PlayerIndex currentOwner = owner_;
   owner_ = player;
   return currentOwner;
 };
@@ -75,6 +83,8 @@ int Army::getLocationX() const { return location_.first; };
 
 int Army::getLocationY() const { return location_.second; };
 
+std::pair<int, int> Army::getXY() const { return location_; };
+
 std::pair<int, int> Army::setLocation(std::pair<int, int> location) {
   std::pair<int, int> currentLocation = location_;
   location_ = location;
@@ -88,7 +98,7 @@ void Army::setUnitCount(int unitCount) { unitCount_ = unitCount; };
 const std::string Army::toString() const {
   std::stringstream ss;
   ss << getName() << std::endl;
-  ss << "Owner: " << owner_->getID() << std::endl;
+  ss << "Owner: " << owner_ + 1 << std::endl;
   ss << "Location: (" << location_.first << ", " << location_.second << ")"
      << std::endl;
   ss << "Unit Count: " << unitCount_ << std::endl;
@@ -104,7 +114,8 @@ void Army::setHasCompletedTurn(bool hasCompletedTurn) {
 ArmyType Army::getType() const { return type_; };
 int Army::getAttack() const { return attack_; };
 int Army::getDefense() const { return defense_; };
+int Army::getSpeed() const { return speed_; };
 bool Army::canAdvance(TileType type) {
-  return type == GRASS || (type_ == MARINE && type == WATER);
+  return canTraverse(getMovementClass(type_), type);
 };
 void Army::incrementUnitCount() { unitCount_++; }
\ No newline at end of file
@@ -8,20 +8,23 @@
 #include "tile.hpp"
 
 enum ArmyType { INFANTRY, CAVALRY, ARTILLERY, MARINE };
+constexpr int NUM_ARMY_TYPES = 4;
 
 std::string getArmyTypeName(ArmyType armyType);
 Resources getArmyDeploymentCost(ArmyType armyType);
+MovementClass getMovementClass(ArmyType armyType);
 
 class Army : public Selectable {
  public:
   Army(ArmyType type, std::pair<int, int> location,
-       std::shared_ptr<Player> owner = nullptr, int unitCount = 0);
+       PlayerIndex owner = NO_PLAYER, int unitCount = 0);
 
-  std::shared_ptr<Player> getOwner() const;
-  std::shared_ptr<Player> setOwner(std::shared_ptr<Player> player);
+  PlayerIndex getOwner() const;
+  PlayerIndex setOwner(PlayerIndex player);
   std::pair<int, int> getLocation() const;
   int getLocationX() const;
   int getLocationY() const;
+  std::pair<int, int> getXY() const;
   std::pair<int, int> setLocation(std::pair<int, int> location);
   int getUnitCount() const;
   void setUnitCount(int unitCount);
@@ -31,17 +34,20 @@ class Army : public Selectable {
   ArmyType getType() const;
   int getAttack() const;
   int getDefense() const;
+  int getSpeed() const;
   bool canAdvance(TileType type);
   void incrementUnitCount();
 
  private:
   ArmyType type_;
-  std::shared_ptr<Player> owner_;
+  PlayerIndex owner_;
   std::pair<int, int> location_;
   int unitCount_;
   bool hasCompletedTurn_;
   int attack_;
   int defense_;
+  // number of tiles the army can move per turn
+  int speed_;
 };
 
 #endif
\ No newline at end of file
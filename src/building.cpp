@@ -1,7 +1,6 @@
 #include "building.hpp"
 
 BuildingBlueprint::BuildingBlueprint() : Selectable("Blueprint") {
-  std::cout << "BuildingBlueprint constructor called, setting label to 'Blueprint'" << std::endl;
   setLabel("Blueprint");
 }
 
@@ -50,8 +49,7 @@ Resources BuildingBlueprint::getResourceGain() const { return resourceGain_; };
 std::atomic<int> Building::idCounter_{0};
 
 Building::Building(BuildingType type, Resources resourceCost,
-                   Resources resourceGain, std::shared_ptr<Player> owner, int x,
-                   int y)
+                   Resources resourceGain, PlayerIndex owner, int x, int y)
     : Selectable("Building"),
       type_(type),
       resourceCost_(resourceCost),
@@ -75,18 +73,20 @@ std::pair<int, int> Building::getXY() const {
 
 BuildingType Building::getType() const { return type_; }
 
-std::shared_ptr<Player> Building::setOwner(std::shared_ptr<Player> player) {
-  auto previousOwner = owner_;
+PlayerIndex Building::setOwner(PlayerIndex player) {
+  PlayerIndex previousOwner = owner_;
   owner_ = player;
   return previousOwner;
 }
 
-std::shared_ptr<Player> Building::getOwner() const { return owner_; }
+PlayerIndex Building::getOwner() const { return owner_; }
 
 Resources Building::getResourceCost() const { return resourceCost_; }
 
-Resources Building::nextTurn() const {
-  switch (type_) {
+Resources Building::nextTurn() const { return getBuildingProduction(type_); }
+
+Resources getBuildingProduction(BuildingType type) {
+  switch (type) {
     case WOOD_CUTTER:
       return Resources(0, 20, 0, 0);
     case FARM:
@@ -106,9 +106,9 @@ std::vector<std::string> Building::getInfo() const {
   // owner information
   std::string ownerName = "Owner: None";
 
-  if (owner_ != nullptr) {
+  if (owner_ != NO_PLAYER) {
     ownerName = "Owner: Player ";
-    ownerName += std::to_string(owner_->getID());
+    ownerName += std::to_string(owner_ + 1);
   }
 
   lines.push_back(ownerName);
@@ -1,9 +1,9 @@
 #ifndef BUILDING_HPP
 #define BUILDING_HPP
 
-#include <SFML/Graphics.hpp>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <utility>
 
 #include "player.hpp"
@@ -11,6 +11,16 @@
 
 enum BuildingType { WOOD_CUTTER, FARM, MARKET, MINE };
 
+constexpr int NUM_BUILDING_TYPES = 4;
+
+/**
+ * @brief Get the resources a building of a type produces every turn
+ *
+ * @param type
+ * @return Resources
+ */
+Resources getBuildingProduction(BuildingType type);
+
 class BuildingBlueprint : public Selectable {
  public:
   /**
@@ -51,7 +61,7 @@ class Building : public Selectable {
    * @param y
    */
   Building(BuildingType type, Resources resourceCost, Resources resourceGain,
-           std::shared_ptr<Player> owner = nullptr, int x = 0, int y = 0);
+           PlayerIndex owner = NO_PLAYER, int x = 0, int y = 0);
 
   /**
    * @brief Get the Id of the building.
@@ -94,14 +104,14 @@ class Building : public Selectable {
    * @param player
    * @return Previous owner.
    */
-  std::shared_ptr<Player> setOwner(std::shared_ptr<Player> player);
+  PlayerIndex setOwner(PlayerIndex player);
 
   /**
    * @brief Get the owner of the building.
    *
-   * @return Current owner.
+   * @return Current owner, NO_PLAYER if the building has none.
    */
-  std::shared_ptr<Player> getOwner() const;
+  PlayerIndex getOwner() const;
 
   /**
    * @brief Get the resource cost for the building.
@@ -140,7 +150,7 @@ class Building : public Selectable {
   BuildingType type_;
   Resources resourceCost_;
   Resources resourceGain_;
-  std::shared_ptr<Player> owner_;
+  PlayerIndex owner_;
   int x_;
   int y_;
   static std::atomic<int> idCounter_;
@@ -0,0 +1,162 @@
+#include "camera.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "uimanager.hpp"
+
+namespace {
+
+// Tiles are shown at most four times their size
+const float MIN_ZOOM = 0.25f;
+// Zooming out further makes the tiles too small to click and would visit too
+// many of them every frame
+const float MAX_ZOOM = 8;
+
+const float PITCH = TILE_SIZE + OUTLINE_SIZE;
+
+}  // namespace
+
+void Camera::setMapSize(int numCols, int numRows) {
+  if (numCols == numCols_ && numRows == numRows_) return;
+  numCols_ = numCols;
+  numRows_ = numRows;
+  reset();
+}
+
+void Camera::reset() {
+  // The outline around a tile lies one pixel outside of it
+  sf::IntRect area = getMapArea(numCols_, numRows_);
+  screen_ = sf::FloatRect(area.left - 1, area.top - 1, area.width,
+                          area.height);
+  zoom_ = 1;
+  view_.reset(screen_);
+  view_.setViewport(sf::FloatRect(
+      screen_.left / WINDOW_WIDTH, screen_.top / WINDOW_HEIGHT,
+      screen_.width / WINDOW_WIDTH, screen_.height / WINDOW_HEIGHT));
+  clamp();
+}
+
+void Camera::pan(float dx, float dy) {
+  view_.move(dx * zoom_, dy * zoom_);
+  clamp();
+}
+
+void Camera::zoom(float factor) {
+  float newZoom = std::clamp(zoom_ * factor, MIN_ZOOM, getMaxZoom());
+  view_.setSize(screen_.width * newZoom, screen_.height * newZoom);
+  zoom_ = newZoom;
+  clamp();
+}
+
+void Camera::zoom(float factor, const sf::RenderTarget& target,
+                  sf::Vector2i pixel) {
+  if (!screen_.contains(pixel.x, pixel.y)) {
+    zoom(factor);
+    return;
+  }
+  sf::Vector2f anchor = target.mapPixelToCoords(pixel, view_);
+  sf::Vector2f center = view_.getCenter();
+  float oldZoom = zoom_;
+  zoom(factor);
+  // Move the point that was under the pixel back under it
+  view_.setCenter(center + (anchor - center) * (1 - zoom_ / oldZoom));
+  clamp();
+}
+
+bool Camera::processEvent(const sf::Event& event,
+                          const sf::RenderTarget& target) {
+  if (event.type == sf::Event::MouseWheelScrolled) {
+    if (event.mouseWheelScroll.wheel != sf::Mouse::VerticalWheel) return false;
+    // Scrolling up zooms in on the tile under the mouse
+    float factor = event.mouseWheelScroll.delta > 0 ? 1 / CAMERA_ZOOM_STEP
+                                                    : CAMERA_ZOOM_STEP;
+    sf::Vector2i pixel(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+    zoom(factor, target, pixel);
+    return true;
+  }
+  if (event.type != sf::Event::KeyPressed) return false;
+
+  switch (event.key.code) {
+    case sf::Keyboard::Left:
+      pan(-CAMERA_PAN_STEP, 0);
+      return true;
+    case sf::Keyboard::Right:
+      pan(CAMERA_PAN_STEP, 0);
+      return true;
+    case sf::Keyboard::Up:
+      pan(0, -CAMERA_PAN_STEP);
+      return true;
+    case sf::Keyboard::Down:
+      pan(0, CAMERA_PAN_STEP);
+      return true;
+    case sf::Keyboard::Add:
+    case sf::Keyboard::Equal:
+      zoom(1 / CAMERA_ZOOM_STEP);
+      return true;
+    case sf::Keyboard::Subtract:
+    case sf::Keyboard::Hyphen:
+      zoom(CAMERA_ZOOM_STEP);
+      return true;
+    case sf::Keyboard::Home:
+      reset();
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool Camera::getTileAt(const sf::RenderTarget& target, sf::Vector2i pixel,
+                       int& x, int& y) const {
+  if (!screen_.contains(pixel.x, pixel.y)) return false;
+  sf::Vector2f coords = target.mapPixelToCoords(pixel, view_);
+  x = std::floor((coords.x - LEFT_MAP_OFFSET) / PITCH);
+  y = std::floor((coords.y - TOP_MAP_OFFSET) / PITCH);
+  return x >= 0 && y >= 0 && x < numCols_ && y < numRows_;
+}
+
+sf::IntRect Camera::getVisibleTiles() const {
+  sf::Vector2f center = view_.getCenter();
+  sf::Vector2f size = view_.getSize();
+  // Tile x covers LEFT_MAP_OFFSET + x * PITCH - 1 up to the next tile
+  float left = center.x - size.x / 2 - LEFT_MAP_OFFSET + 1;
+  float top = center.y - size.y / 2 - TOP_MAP_OFFSET + 1;
+  int x0 = std::clamp<int>(std::floor(left / PITCH), 0, numCols_);
+  int y0 = std::clamp<int>(std::floor(top / PITCH), 0, numRows_);
+  int x1 = std::clamp<int>(std::ceil((left + size.x) / PITCH), x0, numCols_);
+  int y1 = std::clamp<int>(std::ceil((top + size.y) / PITCH), y0, numRows_);
+  return sf::IntRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+const sf::View& Camera::getView() const { return view_; }
+
+float Camera::getZoom() const { return zoom_; }
+
+float Camera::getMaxZoom() const {
+  if (screen_.width <= 0 || screen_.height <= 0) return 1;
+  // No need to zoom out further than it takes to see the whole map
+  float fit = std::max(numCols_ * PITCH / screen_.width,
+                       numRows_ * PITCH / screen_.height);
+  return std::clamp(fit, 1.f, MAX_ZOOM);
+}
+
+void Camera::clamp() {
+  sf::Vector2f center = view_.getCenter();
+  sf::Vector2f size = view_.getSize();
+  sf::Vector2f mapSize(numCols_ * PITCH, numRows_ * PITCH);
+  sf::Vector2f mapPosition(LEFT_MAP_OFFSET - 1, TOP_MAP_OFFSET - 1);
+
+  if (size.x >= mapSize.x) {
+    center.x = mapPosition.x + mapSize.x / 2;
+  } else {
+    center.x = std::clamp(center.x, mapPosition.x + size.x / 2,
+                          mapPosition.x + mapSize.x - size.x / 2);
+  }
+  if (size.y >= mapSize.y) {
+    center.y = mapPosition.y + mapSize.y / 2;
+  } else {
+    center.y = std::clamp(center.y, mapPosition.y + size.y / 2,
+                          mapPosition.y + mapSize.y - size.y / 2);
+  }
+  view_.setCenter(center);
+}
@@ -0,0 +1,120 @@
+#ifndef SRC_CAMERA_HPP_
+#define SRC_CAMERA_HPP_
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief The part of the map shown in the map area of the window, which can
+ * be panned and zoomed.
+ *
+ * Wraps an sf::View whose viewport is the map area. Things on the map are
+ * drawn in the coordinates they would have on screen without panning or
+ * zooming, tile x, y at LEFT_MAP_OFFSET + x * (TILE_SIZE + OUTLINE_SIZE) and
+ * TOP_MAP_OFFSET + y * (TILE_SIZE + OUTLINE_SIZE), and the view maps them to
+ * the window. The camera never leaves the map, maps smaller than the view
+ * are centered in it.
+ */
+class Camera {
+ public:
+  /**
+   * @brief Sets the size of the map shown, resetting the camera if it changed
+   *
+   * @param numCols
+   * @param numRows
+   */
+  void setMapSize(int numCols, int numRows);
+
+  /**
+   * @brief Shows the top left corner of the map without zoom
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Moves the camera
+   *
+   * @param dx pixels of the window to move right by
+   * @param dy pixels of the window to move down by
+   */
+  void pan(float dx, float dy);
+
+  /**
+   * @brief Zooms around the center of the map area
+   *
+   * @param factor below 1 zooms in, above 1 zooms out
+   */
+  void zoom(float factor);
+
+  /**
+   * @brief Zooms around a pixel, keeping the tile under it in place
+   *
+   * Zooms around the center of the map area if the pixel lies outside of it.
+   *
+   * @param factor below 1 zooms in, above 1 zooms out
+   * @param target window the map is drawn to
+   * @param pixel
+   */
+  void zoom(float factor, const sf::RenderTarget& target, sf::Vector2i pixel);
+
+  /**
+   * @brief Pans or zooms if the event is one of the camera controls
+   *
+   * The arrow keys pan, + and - zoom, Home resets the camera and the mouse
+   * wheel zooms around the mouse.
+   *
+   * @param event
+   * @param target window the map is drawn to
+   * @return true if the event was handled
+   */
+  bool processEvent(const sf::Event& event, const sf::RenderTarget& target);
+
+  /**
+   * @brief Get the tile shown at a pixel of the window
+   *
+   * @param target window the map is drawn to
+   * @param pixel
+   * @param x set to the column of the tile
+   * @param y set to the row of the tile
+   * @return false if the pixel is not on a tile of the map
+   */
+  bool getTileAt(const sf::RenderTarget& target, sf::Vector2i pixel, int& x,
+                 int& y) const;
+
+  /**
+   * @brief Get the tiles that are at least partly on screen
+   *
+   * @return sf::IntRect columns left to left + width - 1 and rows top to
+   * top + height - 1, empty if there is no map
+   */
+  sf::IntRect getVisibleTiles() const;
+
+  /**
+   * @brief Get the view to draw the map with
+   *
+   * @return const sf::View&
+   */
+  const sf::View& getView() const;
+
+  /**
+   * @brief Get the zoom level
+   *
+   * @return float size of the shown part of the map relative to its size on
+   * screen, below 1 when zoomed in
+   */
+  float getZoom() const;
+
+ private:
+  float getMaxZoom() const;
+
+  // Keeps the view within the map
+  void clamp();
+
+  int numCols_ = 0;
+  int numRows_ = 0;
+  // Part of the window the map is shown in
+  sf::FloatRect screen_;
+  float zoom_ = 1;
+  sf::View view_;
+};
+
+#endif  // SRC_CAMERA_HPP_
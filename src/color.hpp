@@ -0,0 +1,39 @@
+#ifndef SRC_COLOR_HPP_
+#define SRC_COLOR_HPP_
+
+#include <cstdint>
+
+/**
+ * @brief RGBA color of a player.
+ *
+ * The simulation core does not depend on SFML, the UI converts this to an
+ * sf::Color when drawing.
+ */
+struct Color {
+  uint8_t r = 0;
+  uint8_t g = 0;
+  uint8_t b = 0;
+  uint8_t a = 255;
+
+  constexpr Color() = default;
+  constexpr Color(uint8_t red, uint8_t green, uint8_t blue,
+                  uint8_t alpha = 255)
+      : r(red), g(green), b(blue), a(alpha) {}
+
+  bool operator==(const Color& other) const {
+    return r == other.r && g == other.g && b == other.b && a == other.a;
+  }
+  bool operator!=(const Color& other) const { return !(*this == other); }
+
+  static const Color Red;
+  static const Color Green;
+  static const Color Blue;
+  static const Color Yellow;
+};
+
+inline const Color Color::Red{255, 0, 0};
+inline const Color Color::Green{0, 255, 0};
+inline const Color Color::Blue{0, 0, 255};
+inline const Color Color::Yellow{255, 255, 0};
+
+#endif  // SRC_COLOR_HPP_
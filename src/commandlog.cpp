@@ -0,0 +1,28 @@
+#include "commandlog.hpp"
+
+#include <utility>
+
+void CommandLog::push(Command command) {
+  commands_.erase(commands_.begin() + position_, commands_.end());
+  commands_.push_back(std::move(command));
+  position_++;
+}
+
+Command* CommandLog::undo() {
+  if (!canUndo()) return nullptr;
+  return &commands_[--position_];
+}
+
+Command* CommandLog::redo() {
+  if (!canRedo()) return nullptr;
+  return &commands_[position_++];
+}
+
+bool CommandLog::canUndo() const { return position_ > 0; }
+
+bool CommandLog::canRedo() const { return position_ < commands_.size(); }
+
+void CommandLog::clear() {
+  commands_.clear();
+  position_ = 0;
+}
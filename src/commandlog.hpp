@@ -0,0 +1,73 @@
+#ifndef SRC_COMMANDLOG_HPP_
+#define SRC_COMMANDLOG_HPP_
+
+#include <functional>
+#include <vector>
+
+#include "journal.hpp"
+
+/**
+ * @brief An action that was carried out, and how to take it back.
+ *
+ * The undo steps are recorded by GameState while the action runs: every
+ * change it makes to the game adds the step that reverses it. Running them
+ * last to first restores the game to how it was before the action.
+ */
+struct Command {
+  /**
+   * @brief Construct a command for an action, without undo steps yet
+   *
+   * @param action
+   */
+  explicit Command(const Action& action) : action(action) {}
+
+  Action action;
+  std::vector<std::function<void()>> undoSteps;
+};
+
+/**
+ * @brief History of commands with a cursor for undo and redo.
+ *
+ * Commands before the cursor have been carried out, the ones after it have
+ * been undone and can be redone. Pushing a new command drops everything that
+ * could have been redone, like text editors do.
+ */
+class CommandLog {
+ public:
+  /**
+   * @brief Adds a command that has just been carried out
+   *
+   * @param command
+   */
+  void push(Command command);
+
+  /**
+   * @brief Moves the cursor back by one command
+   *
+   * @return Command* the command to undo, nullptr if there is none
+   */
+  Command* undo();
+
+  /**
+   * @brief Moves the cursor forward by one command
+   *
+   * @return Command* the command to carry out again, nullptr if there is none
+   */
+  Command* redo();
+
+  bool canUndo() const;
+  bool canRedo() const;
+
+  /**
+   * @brief Forgets all commands
+   *
+   */
+  void clear();
+
+ private:
+  std::vector<Command> commands_;
+  // number of commands that are carried out
+  size_t position_ = 0;
+};
+
+#endif  // SRC_COMMANDLOG_HPP_
@@ -0,0 +1,75 @@
+#include "connectedcomponents.hpp"
+
+#include "grid.hpp"
+
+void ConnectedComponents::build(const std::vector<uint8_t>& terrain,
+                                int numRows) {
+  numRows_ = numRows;
+  for (int movement = 0; movement < NUM_MOVEMENT_CLASSES; movement++) {
+    label(terrain, static_cast<MovementClass>(movement));
+  }
+}
+
+void ConnectedComponents::update(const std::vector<uint8_t>& terrain,
+                                 int index, TileType oldType) {
+  TileType newType = static_cast<TileType>(terrain[index]);
+  for (int movement = 0; movement < NUM_MOVEMENT_CLASSES; movement++) {
+    MovementClass m = static_cast<MovementClass>(movement);
+    // Swapping one passable type for another connects and splits nothing
+    if (canTraverse(m, oldType) != canTraverse(m, newType)) label(terrain, m);
+  }
+}
+
+int ConnectedComponents::getComponent(MovementClass movement,
+                                      int index) const {
+  const std::vector<int>& labels = labels_[movement];
+  if (index < 0 || index >= static_cast<int>(labels.size())) return -1;
+  return labels[index];
+}
+
+bool ConnectedComponents::isConnected(MovementClass movement, int from,
+                                      int to) const {
+  int component = getComponent(movement, from);
+  return component != -1 && component == getComponent(movement, to);
+}
+
+int ConnectedComponents::getComponentCount(MovementClass movement) const {
+  return counts_[movement];
+}
+
+void ConnectedComponents::label(const std::vector<uint8_t>& terrain,
+                                MovementClass movement) {
+  std::vector<int>& labels = labels_[movement];
+  labels.assign(terrain.size(), -1);
+  counts_[movement] = 0;
+  if (numRows_ <= 0) return;
+  int numTiles = terrain.size();
+  int numCols = numTiles / numRows_;
+
+  // Flood fill every passable tile that has no label yet
+  std::vector<int> stack;
+  for (int start = 0; start < numTiles; start++) {
+    if (labels[start] != -1 ||
+        !canTraverse(movement, static_cast<TileType>(terrain[start])))
+      continue;
+
+    int component = counts_[movement]++;
+    labels[start] = component;
+    stack.push_back(start);
+    while (!stack.empty()) {
+      int index = stack.back();
+      stack.pop_back();
+      forEachNeighbour<FOUR_CONNECTED>(
+          index / numRows_, index % numRows_, numCols, numRows_,
+          [&](int x, int y) {
+            int neighbour = x * numRows_ + y;
+            if (labels[neighbour] != -1 ||
+                !canTraverse(movement,
+                             static_cast<TileType>(terrain[neighbour])))
+              return;
+            labels[neighbour] = component;
+            stack.push_back(neighbour);
+          });
+    }
+  }
+}
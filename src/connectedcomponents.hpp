@@ -0,0 +1,79 @@
+#ifndef SRC_CONNECTEDCOMPONENTS_HPP_
+#define SRC_CONNECTEDCOMPONENTS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "tile.hpp"
+
+/**
+ * @brief Labels the regions of the map a movement class can travel within.
+ *
+ * Two tiles get the same label for a movement class if a unit of that class
+ * can walk from one to the other, moving horizontally and vertically over
+ * terrain it can cross. That answers "can this army ever get there?" with one
+ * comparison, before any path is searched.
+ *
+ * Only terrain is taken into account. Tiles are addressed like GameState does,
+ * column-major with numRows tiles per column.
+ */
+class ConnectedComponents {
+ public:
+  /**
+   * @brief Labels all tiles for every movement class
+   *
+   * @param terrain TileType of every tile
+   * @param numRows
+   */
+  void build(const std::vector<uint8_t>& terrain, int numRows);
+
+  /**
+   * @brief Updates the labels after the type of one tile changed
+   *
+   * Only the movement classes for which the tile became passable or
+   * impassable are relabeled.
+   *
+   * @param terrain TileType of every tile, already containing the change
+   * @param index tile that changed
+   * @param oldType type of the tile before the change
+   */
+  void update(const std::vector<uint8_t>& terrain, int index,
+              TileType oldType);
+
+  /**
+   * @brief Get the label of a tile
+   *
+   * @param movement
+   * @param index
+   * @return int, -1 if the movement class cannot enter the tile
+   */
+  int getComponent(MovementClass movement, int index) const;
+
+  /**
+   * @brief Check if a unit on one tile can reach another
+   *
+   * @param movement
+   * @param from
+   * @param to
+   * @return true if both tiles can be entered and lie in the same region
+   */
+  bool isConnected(MovementClass movement, int from, int to) const;
+
+  /**
+   * @brief Get the number of separate regions of a movement class
+   *
+   * @param movement
+   * @return int
+   */
+  int getComponentCount(MovementClass movement) const;
+
+ private:
+  void label(const std::vector<uint8_t>& terrain, MovementClass movement);
+
+  int numRows_ = 0;
+  std::array<std::vector<int>, NUM_MOVEMENT_CLASSES> labels_;
+  std::array<int, NUM_MOVEMENT_CLASSES> counts_{};
+};
+
+#endif  // SRC_CONNECTEDCOMPONENTS_HPP_
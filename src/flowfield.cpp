@@ -0,0 +1,64 @@
+#include "flowfield.hpp"
+
+#include <stdexcept>
+
+#include "grid.hpp"
+
+FlowField::FlowField(const std::vector<uint8_t>& terrain, int numRows,
+                     int targetX, int targetY, MovementClass movement)
+    : numRows_(numRows),
+      numCols_(numRows > 0 ? terrain.size() / numRows : 0),
+      targetX_(targetX),
+      targetY_(targetY),
+      movement_(movement),
+      distance_(terrain.size(), -1),
+      next_(terrain.size(), -1) {
+  if (!isInside(targetX, targetY))
+    throw std::out_of_range("Invalid target coordinates");
+
+  // The queue never holds a tile twice, so a vector the size of the map with
+  // a read position is enough
+  std::vector<int> queue;
+  queue.reserve(terrain.size());
+  int target = targetX * numRows_ + targetY;
+  distance_[target] = 0;
+  queue.push_back(target);
+
+  for (size_t head = 0; head < queue.size(); head++) {
+    int index = queue[head];
+    forEachNeighbour<FOUR_CONNECTED>(
+        index / numRows_, index % numRows_, numCols_, numRows_,
+        [&](int nx, int ny) {
+          int neighbour = nx * numRows_ + ny;
+          if (distance_[neighbour] != -1) return;
+          if (!canTraverse(movement_,
+                           static_cast<TileType>(terrain[neighbour])))
+            return;
+          distance_[neighbour] = distance_[index] + 1;
+          next_[neighbour] = index;
+          queue.push_back(neighbour);
+        });
+  }
+}
+
+int FlowField::getDistance(int x, int y) const {
+  if (!isInside(x, y)) return -1;
+  return distance_[x * numRows_ + y];
+}
+
+std::pair<int, int> FlowField::getNextStep(int x, int y) const {
+  if (!isInside(x, y)) return std::make_pair(-1, -1);
+  int next = next_[x * numRows_ + y];
+  if (next == -1) return std::make_pair(-1, -1);
+  return std::make_pair(next / numRows_, next % numRows_);
+}
+
+int FlowField::getTargetX() const { return targetX_; }
+
+int FlowField::getTargetY() const { return targetY_; }
+
+MovementClass FlowField::getMovementClass() const { return movement_; }
+
+bool FlowField::isInside(int x, int y) const {
+  return x >= 0 && y >= 0 && x < numCols_ && y < numRows_;
+}
@@ -0,0 +1,80 @@
+#ifndef SRC_FLOWFIELD_HPP_
+#define SRC_FLOWFIELD_HPP_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "tile.hpp"
+
+/**
+ * @brief Shortest paths from every tile of the map to one target tile.
+ *
+ * Built with a single breadth first search outward from the target over the
+ * tiles a movement class can cross, moving horizontally and vertically. Every
+ * reached tile stores its distance to the target and the neighbour one step
+ * closer, so any number of armies heading to the same target look up their
+ * next step in constant time.
+ *
+ * Only terrain is taken into account. Armies, buildings and owners do not
+ * block the field, the caller decides whether the step can be taken this turn.
+ *
+ * Tiles are addressed like GameState does, column-major with numRows tiles per
+ * column.
+ */
+class FlowField {
+ public:
+  /**
+   * @brief Builds the field toward a target
+   *
+   * The target itself is always part of the field, even if the movement class
+   * cannot enter it.
+   *
+   * @param terrain TileType of every tile
+   * @param numRows
+   * @param targetX
+   * @param targetY
+   * @param movement
+   */
+  FlowField(const std::vector<uint8_t>& terrain, int numRows, int targetX,
+            int targetY, MovementClass movement);
+
+  /**
+   * @brief Get the number of steps from a tile to the target
+   *
+   * @param x
+   * @param y
+   * @return int, -1 if the target cannot be reached from the tile
+   */
+  int getDistance(int x, int y) const;
+
+  /**
+   * @brief Get the neighbour to move to from a tile to get closer to the
+   * target
+   *
+   * @param x
+   * @param y
+   * @return std::pair<int, int>, (-1, -1) if the tile is the target or the
+   * target cannot be reached from it
+   */
+  std::pair<int, int> getNextStep(int x, int y) const;
+
+  int getTargetX() const;
+  int getTargetY() const;
+  MovementClass getMovementClass() const;
+
+ private:
+  bool isInside(int x, int y) const;
+
+  int numRows_;
+  int numCols_;
+  int targetX_;
+  int targetY_;
+  MovementClass movement_;
+  // Per tile the distance to the target and the index of the next tile on
+  // the way there, -1 where the target is out of reach
+  std::vector<int> distance_;
+  std::vector<int> next_;
+};
+
+#endif  // SRC_FLOWFIELD_HPP_
@@ -0,0 +1,48 @@
+#include "fogofwar.hpp"
+
+void FogOfWar::reset(int numPlayers, int numTiles) {
+  numTiles_ = numTiles;
+  viewers_.assign(numPlayers, std::vector<uint16_t>(numTiles, 0));
+  bits_.assign(numPlayers, std::vector<uint64_t>((numTiles + 63) / 64, 0));
+}
+
+bool FogOfWar::addViewer(int player, int index) {
+  if (viewers_[player][index]++ != 0) return false;
+  bits_[player][index / 64] |= uint64_t(1) << (index % 64);
+  return true;
+}
+
+bool FogOfWar::removeViewer(int player, int index) {
+  if (viewers_[player][index] == 0) return false;
+  if (--viewers_[player][index] != 0) return false;
+  bits_[player][index / 64] &= ~(uint64_t(1) << (index % 64));
+  return true;
+}
+
+bool FogOfWar::isVisible(int player, int index) const {
+  if (player < 0 || player >= static_cast<int>(bits_.size()) || index < 0 ||
+      index >= numTiles_)
+    return false;
+  return (bits_[player][index / 64] >> (index % 64)) & 1;
+}
+
+int FogOfWar::findNextVisible(int player, int index) const {
+  if (player < 0 || player >= static_cast<int>(bits_.size()) || index < 0)
+    return numTiles_;
+
+  const std::vector<uint64_t>& bits = bits_[player];
+  int numWords = bits.size();
+  int word = index / 64;
+  if (word >= numWords) return numTiles_;
+
+  // Mask out the bits before index in the first word
+  uint64_t current = bits[word] & (~uint64_t(0) << (index % 64));
+  while (current == 0) {
+    if (++word >= numWords) return numTiles_;
+    current = bits[word];
+  }
+
+  int bit = 0;
+  while (!((current >> bit) & 1)) bit++;
+  return std::min(word * 64 + bit, numTiles_);
+}
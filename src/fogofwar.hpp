@@ -0,0 +1,73 @@
+#ifndef SRC_FOGOFWAR_HPP_
+#define SRC_FOGOFWAR_HPP_
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Per player visibility bitmaps with one bit per map tile.
+ *
+ * Every tile keeps a reference count of the vision sources (owned tiles,
+ * armies, buildings, townhalls) that currently see it. The counts are updated
+ * incrementally as the world changes and the bitmap caches whether a count is
+ * non-zero, so reading visibility never recomputes anything.
+ *
+ * Tiles are addressed by their map index (see GameState::toIndex). Players are
+ * addressed by their position in the GameState's player list.
+ */
+class FogOfWar {
+ public:
+  /**
+   * @brief Resizes the bitmaps and hides every tile for every player
+   *
+   * @param numPlayers
+   * @param numTiles
+   */
+  void reset(int numPlayers, int numTiles);
+
+  /**
+   * @brief Adds a vision source that sees the tile at index for a player
+   *
+   * @param player
+   * @param index
+   * @return true if the tile was hidden before
+   */
+  bool addViewer(int player, int index);
+
+  /**
+   * @brief Removes a vision source that saw the tile at index for a player.
+   * The tile is hidden again once no source sees it anymore.
+   *
+   * @param player
+   * @param index
+   * @return true if the tile got hidden
+   */
+  bool removeViewer(int player, int index);
+
+  /**
+   * @brief Checks if the tile at index is visible for a player
+   *
+   * @param player
+   * @param index
+   * @return true
+   * @return false
+   */
+  bool isVisible(int player, int index) const;
+
+  /**
+   * @brief Finds the first tile at or after index that is visible for a
+   * player. Hidden tiles are skipped 64 at a time.
+   *
+   * @param player
+   * @param index
+   * @return int The tile index, or the number of tiles if there is none
+   */
+  int findNextVisible(int player, int index) const;
+
+ private:
+  int numTiles_ = 0;
+  std::vector<std::vector<uint16_t>> viewers_;
+  std::vector<std::vector<uint64_t>> bits_;
+};
+
+#endif  // SRC_FOGOFWAR_HPP_
@@ -1,30 +1,119 @@
 #include "gamestate.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <iterator>
+#include <random>
 
-GameState::GameState(std::shared_ptr<sf::RenderWindow> window, int turn)
-    : window_(window), turn_(turn) {}
+namespace {
+
+const uint8_t SNAPSHOT_MAGIC[4] = {'S', '8', 'S', 'S'};
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+}  // namespace
+
+GameState::GameState(int turn) : turn_(turn) {
+  std::random_device rd;
+  seed_ = (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+void GameState::setSeed(uint64_t seed) {
+  seed_ = seed;
+  for (size_t i = 0; i < randoms_.size(); i++) randoms_[i].seed(seed_, i);
+}
+
+uint64_t GameState::getSeed() const { return seed_; }
+
+Random& GameState::getRandom(PlayerIndex player) {
+  if (player >= randoms_.size())
+    throw std::out_of_range("Player is not part of the game");
+  return randoms_[player];
+}
 
 void GameState::tick() { players_[turn_ % players_.size()]->doTurn(); }
 
 void GameState::addPlayer(std::shared_ptr<Player> player) {
+  if (players_.size() >= NO_PLAYER)
+    throw std::length_error("Too many players in one game");
+  player->setIndex(players_.size());
+  randoms_.emplace_back(seed_, players_.size());
   players_.push_back(std::move(player));
+  rebuildOwnedTiles();
+  rebuildIncome();
+  isFogDirty_ = true;
+  markMapChanged();
+}
+
+const std::shared_ptr<Player>& GameState::getPlayer(PlayerIndex index) const {
+  static const std::shared_ptr<Player> noPlayer = nullptr;
+  if (index >= players_.size()) return noPlayer;
+  return players_[index];
+}
+
+PlayerIndex GameState::getPlayerIndex(
+    const std::shared_ptr<Player>& player) const {
+  if (!player || getPlayer(player->getIndex()) != player) return NO_PLAYER;
+  return player->getIndex();
 }
 
 int GameState::getActivePlayerID() { return activePlayerID_; }
 
+int GameState::getTurn() const { return turn_; }
+
+uint64_t GameState::getMapRevision() const { return mapRevision_; }
+
+bool GameState::getChangedTiles(uint64_t revision,
+                                std::vector<int>& tiles) const {
+  tiles.clear();
+  if (revision < mapChangesBase_ || revision > mapRevision_) return false;
+  tiles.assign(mapChanges_.begin() + (revision - mapChangesBase_),
+               mapChanges_.end());
+  return true;
+}
+
 void GameState::addBuilding(const Building& building) {
+  if (journal_) {
+    Action action;
+    action.type = ADD_BUILDING;
+    action.x = building.getX();
+    action.y = building.getY();
+    action.player = building.getOwner();
+    action.unitType = building.getType();
+    action.cost = building.getResourceCost();
+    action.gain = building.nextTurn();
+    journal_->record(action);
+  }
   buildings_.push_back(building);
+  int x = building.getX();
+  int y = building.getY();
+  if (areCoordinatesValid(x, y) && buildingGrid_[toIndex(x, y)] == -1)
+    buildingGrid_[toIndex(x, y)] = buildings_.size() - 1;
+  addVisionSource(building.getOwner(), x, y);
+  updateIncome(building, 1);
+  if (undoSteps_) {
+    int index = buildings_.size() - 1;
+    undoSteps_->push_back([this, index] { eraseBuilding(index); });
+  }
 }
 
 void GameState::addTownhall(const TownHall& townhall) {
   townhalls_.push_back(townhall);
+  int x = townhall.getX();
+  int y = townhall.getY();
+  if (areCoordinatesValid(x, y) && townhallGrid_[toIndex(x, y)] == -1)
+    townhallGrid_[toIndex(x, y)] = townhalls_.size() - 1;
+  addVisionSource(townhall.getOwner(), x, y);
 }
 
-void GameState::addArmy(ArmyType type, int x, int y,
-                        std::shared_ptr<Player> owner, int unitCount) {
+void GameState::addArmy(ArmyType type, int x, int y, PlayerIndex owner,
+                        int unitCount) {
   Army army(type, std::make_pair(x, y), owner, unitCount);
-  armies_.push_back(army);
+  ArmyHandle handle = armies_.insert(army);
+  if (areCoordinatesValid(x, y) && !tileHasArmy(x, y))
+    armyGrid_[toIndex(x, y)] = handle;
+  addVisionSource(owner, x, y);
+  if (undoSteps_) undoSteps_->push_back([this, handle] { eraseArmy(handle); });
   // std::cout << "added new army at " << x << " " << y << " for " << owner <<
   // std::endl;
 }
@@ -33,71 +122,509 @@ void GameState::setActivePlayerID(int playerID) { activePlayerID_ = playerID; }
 
 void GameState::loadMap(const std::vector<Tile>& tiles, int num_rows) {
   num_rows_ = num_rows;
-  map_ = tiles;
+  terrain_.assign(tiles.size(), GRASS);
+  owners_.assign(tiles.size(), NO_PLAYER);
+  for (size_t i = 0; i < tiles.size(); i++) {
+    terrain_[i] = tiles[i].getType();
+    owners_[i] = tiles[i].getOwner();
+  }
+  onMapLoaded();
 }
 
 void GameState::loadMapFromString(const std::string str, int num_rows) {
-  std::vector<Tile> tiles;
+  num_rows_ = num_rows;
+  terrain_.assign(str.size(), GRASS);
+  owners_.assign(str.size(), NO_PLAYER);
   for (int i = 0; i < str.size(); i++) {
-    // std::cout << str[i] << std::endl;
     switch (str[i]) {
-      case 'G':
-        tiles.push_back(Tile(i / num_rows, i % num_rows));
-        break;
       case 'W':
-        tiles.push_back(Tile(i / num_rows, i % num_rows, WATER));
+        terrain_[i] = WATER;
         break;
       case 'R':
-        tiles.push_back(Tile(i / num_rows, i % num_rows, ROCK));
+        terrain_[i] = ROCK;
         break;
       default:
-        tiles.push_back(Tile(i / num_rows, i % num_rows));
+        terrain_[i] = GRASS;
         break;
     }
   }
-
-  loadMap(tiles, num_rows);
+  onMapLoaded();
 }
 
-Tile& GameState::getTile(int xPos, int yPos) {
-  int idx = xPos * num_rows_ + yPos;
+void GameState::loadMap(const MapFile& map) {
+  loadMapFromString(map.getTiles(), map.getNumRows());
+}
 
-  if (areCoordinatesValid(xPos, yPos)) {
-    return map_[idx];
+void GameState::loadMap(const MappedMap& map) {
+  num_rows_ = map.getNumRows();
+  int size = map.getNumCols() * num_rows_;
+  terrain_.assign(map.getTerrain(), map.getTerrain() + size);
+  if (map.getOwners()) {
+    owners_.assign(map.getOwners(), map.getOwners() + size);
   } else {
-    throw std::out_of_range("Invalid tile coordinates");
+    owners_.assign(size, NO_PLAYER);
+  }
+  onMapLoaded();
+}
+
+void GameState::saveMap(const std::string& filename) const {
+  MappedMap::save(filename, getNumCols(), num_rows_, terrain_, owners_);
+}
+
+void GameState::writeSnapshot(SnapshotWriter& writer) const {
+  writer.writeBytes(SNAPSHOT_MAGIC, 4);
+  writer.writeU32(SNAPSHOT_VERSION);
+  writer.writeI32(turn_);
+
+  // Player IDs are handed out per process, the active player is saved by
+  // index
+  PlayerIndex active = NO_PLAYER;
+  for (const std::shared_ptr<Player>& player : players_) {
+    if (player->getID() == activePlayerID_) active = player->getIndex();
+  }
+  writer.writeU8(active);
+
+  writer.writeU64(seed_);
+  writer.writeU32(players_.size());
+  for (size_t i = 0; i < players_.size(); i++) {
+    writer.writeU64(randoms_[i].getState());
+    writer.writeU64(randoms_[i].getIncrement());
+    // Length first, so a reader can check the player consumed all of it
+    SnapshotWriter playerState;
+    players_[i]->saveState(playerState);
+    writer.writeU32(playerState.getData().size());
+    writer.writeBytes(playerState.getData().data(),
+                      playerState.getData().size());
+  }
+
+  writer.writeU32(getNumCols());
+  writer.writeU32(num_rows_);
+  writer.writeBytes(terrain_.data(), terrain_.size());
+  writer.writeBytes(owners_.data(), owners_.size());
+
+  writer.writeU32(townhalls_.size());
+  for (const TownHall& townhall : townhalls_) {
+    writer.writeI32(townhall.getId());
+    writer.writeI32(townhall.getSoldierCost());
+    writer.writeU8(townhall.getOwner());
+    writer.writeI32(townhall.getX());
+    writer.writeI32(townhall.getY());
+  }
+
+  writer.writeU32(buildings_.size());
+  for (const Building& building : buildings_) {
+    writer.writeU8(building.getType());
+    writeResources(writer, building.getResourceCost());
+    writeResources(writer, building.nextTurn());
+    writer.writeU8(building.getOwner());
+    writer.writeI32(building.getX());
+    writer.writeI32(building.getY());
+  }
+
+  writer.writeU32(armies_.size());
+  for (const Army& army : armies_) {
+    writer.writeU8(army.getType());
+    writer.writeU8(army.getOwner());
+    writer.writeI32(army.getLocationX());
+    writer.writeI32(army.getLocationY());
+    writer.writeI32(army.getUnitCount());
+    writer.writeU8(army.getHasCompletedTurn());
   }
 }
 
+void GameState::readSnapshot(SnapshotReader& reader) {
+  if (!std::equal(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 4, reader.readBytes(4)))
+    throw std::invalid_argument("Not a snapshot");
+  if (reader.readU32() != SNAPSHOT_VERSION)
+    throw std::invalid_argument("Unsupported snapshot version");
+  int turn = reader.readI32();
+  PlayerIndex active = reader.readU8();
+  uint64_t seed = reader.readU64();
+
+  if (reader.readU32() != players_.size())
+    throw std::invalid_argument("Snapshot is of a game with other players");
+  if (active != NO_PLAYER && active >= players_.size())
+    throw std::invalid_argument("Unknown active player in snapshot");
+  auto readOwner = [&]() {
+    PlayerIndex owner = reader.readU8();
+    if (owner != NO_PLAYER && owner >= players_.size())
+      throw std::invalid_argument("Unknown owner in snapshot");
+    return owner;
+  };
+
+  std::vector<Random> randoms(players_.size());
+  std::vector<SnapshotReader> playerStates;
+  for (Random& random : randoms) {
+    uint64_t state = reader.readU64();
+    uint64_t increment = reader.readU64();
+    random.restore(state, increment);
+    playerStates.push_back(reader.readBlock(reader.readU32()));
+  }
+
+  uint64_t numCols = reader.readU32();
+  uint64_t numRows = reader.readU32();
+  if (numCols * numRows > INT32_MAX)
+    throw std::invalid_argument("Snapshot map is too large");
+  int size = numCols * numRows;
+  const uint8_t* terrainLayer = reader.readBytes(size);
+  std::vector<uint8_t> terrain(terrainLayer, terrainLayer + size);
+  const uint8_t* ownersLayer = reader.readBytes(size);
+  std::vector<PlayerIndex> owners(ownersLayer, ownersLayer + size);
+  for (int i = 0; i < size; i++) {
+    if (terrain[i] > PLACEHOLDER)
+      throw std::invalid_argument("Unknown tile in snapshot");
+    if (owners[i] != NO_PLAYER && owners[i] >= players_.size())
+      throw std::invalid_argument("Unknown owner in snapshot");
+  }
+
+  std::vector<TownHall> townhalls;
+  for (uint32_t count = reader.readU32(); count > 0; count--) {
+    int id = reader.readI32();
+    int soldierCost = reader.readI32();
+    PlayerIndex owner = readOwner();
+    int x = reader.readI32();
+    int y = reader.readI32();
+    townhalls.push_back(TownHall(id, soldierCost, owner, x, y));
+  }
+
+  std::vector<Building> buildings;
+  for (uint32_t count = reader.readU32(); count > 0; count--) {
+    uint8_t type = reader.readU8();
+    if (type >= NUM_BUILDING_TYPES)
+      throw std::invalid_argument("Unknown building type in snapshot");
+    Resources cost = readResources(reader);
+    Resources gain = readResources(reader);
+    PlayerIndex owner = readOwner();
+    int x = reader.readI32();
+    int y = reader.readI32();
+    buildings.push_back(Building(static_cast<BuildingType>(type), cost, gain,
+                                 owner, x, y));
+  }
+
+  std::vector<Army> armies;
+  for (uint32_t count = reader.readU32(); count > 0; count--) {
+    uint8_t type = reader.readU8();
+    if (type >= NUM_ARMY_TYPES)
+      throw std::invalid_argument("Unknown army type in snapshot");
+    PlayerIndex owner = readOwner();
+    int x = reader.readI32();
+    int y = reader.readI32();
+    int unitCount = reader.readI32();
+    Army army(static_cast<ArmyType>(type), std::make_pair(x, y), owner,
+              unitCount);
+    army.setHasCompletedTurn(reader.readU8());
+    armies.push_back(army);
+  }
+
+  // Every player state is read before any is restored, so a malformed one
+  // leaves all players as they were
+  std::vector<std::function<void()>> restorePlayers;
+  for (size_t i = 0; i < players_.size(); i++) {
+    restorePlayers.push_back(players_[i]->readState(playerStates[i]));
+    if (!playerStates[i].atEnd())
+      throw std::invalid_argument("Player state does not match the snapshot");
+  }
+  if (!reader.atEnd())
+    throw std::invalid_argument("Snapshot has data after its end");
+
+  for (const std::function<void()>& restorePlayer : restorePlayers)
+    restorePlayer();
+
+  turn_ = turn;
+  activePlayerID_ = active == NO_PLAYER ? -1 : players_[active]->getID();
+  seed_ = seed;
+  randoms_ = std::move(randoms);
+  num_rows_ = numRows;
+  terrain_ = std::move(terrain);
+  owners_ = std::move(owners);
+  townhalls_ = std::move(townhalls);
+  buildings_ = std::move(buildings);
+  armies_.clear();
+  for (const Army& army : armies) armies_.insert(army);
+  onMapLoaded();
+  rebuildIncome();
+}
+
+void GameState::setJournal(std::shared_ptr<Journal> journal) {
+  journal_ = std::move(journal);
+  if (!journal_) return;
+
+  std::vector<JournalPlayer> players;
+  for (const std::shared_ptr<Player>& player : players_) {
+    players.push_back(JournalPlayer{player->isComputer(), player->getColor()});
+  }
+  SnapshotWriter writer;
+  writeSnapshot(writer);
+  journal_->begin(seed_, std::move(players), writer.getData());
+}
+
+void GameState::applyAction(const Action& action) {
+  switch (action.type) {
+    case NEXT_TURN:
+      if (journal_) journal_->record(action);
+      advanceTurn();
+      break;
+    case UNDO:
+      if (!undo()) throw std::invalid_argument("There is nothing to undo");
+      break;
+    default:
+      execute(action);
+      break;
+  }
+}
+
+void GameState::execute(const Action& action) {
+  if (action.type == NEXT_TURN || action.type == UNDO)
+    throw std::invalid_argument("The action cannot be undone");
+
+  Command command(action);
+  undoSteps_ = &command.undoSteps;
+  try {
+    perform(action);
+  } catch (...) {
+    undoSteps_ = nullptr;
+    revert(command.undoSteps);
+    throw;
+  }
+  undoSteps_ = nullptr;
+  commands_.push(std::move(command));
+}
+
+bool GameState::undo() {
+  Command* command = commands_.undo();
+  if (command == nullptr) return false;
+  if (journal_) {
+    Action action;
+    action.type = UNDO;
+    journal_->record(action);
+  }
+  revert(command->undoSteps);
+  command->undoSteps.clear();
+  return true;
+}
+
+bool GameState::redo() {
+  Command* command = commands_.redo();
+  if (command == nullptr) return false;
+  // The game is back in the state the action was carried out in, so it
+  // succeeds again
+  undoSteps_ = &command->undoSteps;
+  perform(command->action);
+  undoSteps_ = nullptr;
+  return true;
+}
+
+bool GameState::canUndo() const { return commands_.canUndo(); }
+
+bool GameState::canRedo() const { return commands_.canRedo(); }
+
+void GameState::perform(const Action& action) {
+  auto armyAt = [this](int x, int y) -> Army& {
+    if (!areCoordinatesValid(x, y) || !tileHasArmy(x, y))
+      throw std::invalid_argument("No army is located on the tile");
+    return getArmyByLocation(x, y);
+  };
+
+  switch (action.type) {
+    case MOVE_ARMY: {
+      Army& army = armyAt(action.x, action.y);
+      // moveArmy ignores moves out of range, as an action they are an error
+      if (!areCoordinatesValid(action.toX, action.toY) ||
+          !isArmyWithinMovementRange(army, action.toX, action.toY))
+        throw std::invalid_argument("The army cannot move to the tile");
+      moveArmy(army, action.toX, action.toY);
+      break;
+    }
+    case COLONIZE:
+      colonize(armyAt(action.x, action.y));
+      break;
+    case ADD_BUILDING:
+      if (action.player >= players_.size())
+        throw std::invalid_argument("Unknown player");
+      if (action.unitType >= NUM_BUILDING_TYPES)
+        throw std::invalid_argument("Unknown building type");
+      if (!canPlaceBuilding(action.x, action.y,
+                            players_[action.player]->getID()))
+        throw std::invalid_argument("The building cannot be placed there");
+      addBuilding(Building(static_cast<BuildingType>(action.unitType),
+                           action.cost, action.gain, action.player, action.x,
+                           action.y));
+      // The UI and the AI pay for a building after placing it
+      chargePlayer(action.player, action.cost);
+      break;
+    case PLACE_SOLDIERS:
+      if (action.player >= players_.size())
+        throw std::invalid_argument("Unknown player");
+      if (action.unitType >= NUM_ARMY_TYPES)
+        throw std::invalid_argument("Unknown army type");
+      placeSoldiers(players_[action.player],
+                    static_cast<ArmyType>(action.unitType));
+      break;
+    case INCREMENT_ARMY_UNIT:
+      incrementArmyUnit(armyAt(action.x, action.y));
+      break;
+    case NEXT_TURN:
+    case UNDO:
+      break;
+  }
+}
+
+void GameState::revert(const std::vector<std::function<void()>>& steps) {
+  for (auto it = steps.rbegin(); it != steps.rend(); it++) (*it)();
+}
+
+void GameState::recordArmyState(const Army& army) {
+  if (!undoSteps_) return;
+  ArmyHandle handle = findArmyByLocation(army.getLocationX(),
+                                         army.getLocationY());
+  int unitCount = army.getUnitCount();
+  bool hasCompletedTurn = army.getHasCompletedTurn();
+  undoSteps_->push_back([this, handle, unitCount, hasCompletedTurn] {
+    Army* army = armies_.get(handle);
+    army->setUnitCount(unitCount);
+    army->setHasCompletedTurn(hasCompletedTurn);
+  });
+}
+
+void GameState::chargePlayer(PlayerIndex player, const Resources& cost) {
+  Resources before = players_[player]->getResources();
+  players_[player]->modifyResources(
+      Resources(-cost.food, -cost.wood, -cost.gold, -cost.stone));
+  if (!undoSteps_) return;
+  // Resources do not go below zero, so only what was taken is given back
+  Resources after = players_[player]->getResources();
+  Resources charged(before.food - after.food, before.wood - after.wood,
+                    before.gold - after.gold, before.stone - after.stone);
+  undoSteps_->push_back(
+      [this, player, charged] { players_[player]->modifyResources(charged); });
+}
+
+void GameState::saveSnapshot(const std::string& filename) const {
+  SnapshotWriter writer;
+  writeSnapshot(writer);
+
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file for writing: " +
+                             filename);
+  file.write(reinterpret_cast<const char*>(writer.getData().data()),
+             writer.getData().size());
+  if (!file) throw std::runtime_error("Could not write the file: " + filename);
+}
+
+void GameState::loadSnapshot(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file: " + filename);
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+
+  SnapshotReader reader(data);
+  readSnapshot(reader);
+}
+
+Tile GameState::getTile(int xPos, int yPos) const {
+  if (!areCoordinatesValid(xPos, yPos))
+    throw std::out_of_range("Invalid tile coordinates");
+  int idx = toIndex(xPos, yPos);
+  return Tile(xPos, yPos, static_cast<TileType>(terrain_[idx]), owners_[idx]);
+}
+
+TileType GameState::getTileType(int xPos, int yPos) const {
+  if (!areCoordinatesValid(xPos, yPos))
+    throw std::out_of_range("Invalid tile coordinates");
+  return static_cast<TileType>(terrain_[toIndex(xPos, yPos)]);
+}
+
+void GameState::setTileType(int xPos, int yPos, TileType type) {
+  if (!areCoordinatesValid(xPos, yPos))
+    throw std::out_of_range("Invalid tile coordinates");
+  int idx = toIndex(xPos, yPos);
+  if (terrain_[idx] == type) return;
+  TileType oldType = static_cast<TileType>(terrain_[idx]);
+  terrain_[idx] = type;
+  flowFields_.clear();
+  components_.update(terrain_, idx, oldType);
+  markTileChanged(idx);
+}
+
+PlayerIndex GameState::getTileOwner(int xPos, int yPos) const {
+  if (!areCoordinatesValid(xPos, yPos))
+    throw std::out_of_range("Invalid tile coordinates");
+  return owners_[toIndex(xPos, yPos)];
+}
+
 std::vector<Tile> GameState::getClaimedTiles(
     const std::shared_ptr<Player> player) {
   std::vector<Tile> tiles = std::vector<Tile>();
+  PlayerIndex ownerIndex = getPlayerIndex(player);
+  if (ownerIndex == NO_PLAYER) return tiles;
 
-  for (auto& tile : map_) {
-    if (tile.getOwner() == player) {
-      tiles.push_back(tile);
-    }
+  for (int i : ownedTiles_[ownerIndex]) {
+    tiles.push_back(getTile(i / num_rows_, i % num_rows_));
   }
 
   return tiles;
 }
 
+std::vector<std::pair<int, int>> GameState::getFreeClaimedTiles(
+    const std::shared_ptr<Player>& player) {
+  std::vector<std::pair<int, int>> tiles;
+  PlayerIndex ownerIndex = getPlayerIndex(player);
+  if (ownerIndex == NO_PLAYER) return tiles;
+
+  for (int i : ownedTiles_[ownerIndex]) {
+    if (buildingGrid_[i] == -1 && townhallGrid_[i] == -1)
+      tiles.push_back(std::make_pair(i / num_rows_, i % num_rows_));
+  }
+
+  return tiles;
+}
+
+int GameState::getClaimedTileCount(
+    const std::shared_ptr<Player>& player) const {
+  PlayerIndex ownerIndex = getPlayerIndex(player);
+  if (ownerIndex == NO_PLAYER) return 0;
+  return ownedTiles_[ownerIndex].size();
+}
+
+Resources GameState::getIncome(const std::shared_ptr<Player>& player) const {
+  PlayerIndex ownerIndex = getPlayerIndex(player);
+  if (ownerIndex == NO_PLAYER) return Resources(0, 0, 0, 0);
+  return income_[ownerIndex];
+}
+
+Resources GameState::getIncome(const std::shared_ptr<Player>& player,
+                               BuildingType type) const {
+  int count = getBuildingCount(player, type);
+  Resources gain = getBuildingProduction(type);
+  return Resources(count * gain.food, count * gain.wood, count * gain.gold,
+                   count * gain.stone);
+}
+
+int GameState::getBuildingCount(const std::shared_ptr<Player>& player,
+                                BuildingType type) const {
+  PlayerIndex ownerIndex = getPlayerIndex(player);
+  if (ownerIndex == NO_PLAYER) return 0;
+  return buildingCounts_[ownerIndex][type];
+}
+
 void GameState::claimTile(int x, int y, const std::shared_ptr<Player>& player) {
-  Tile& tile = getTile(x, y);
-  tile.setOwner(player);
+  if (!areCoordinatesValid(x, y))
+    throw std::out_of_range("Invalid tile coordinates");
+  setTileOwner(x, y, getPlayerIndex(player));
 }
 
 void GameState::nextTurn() {
-  int pastPlayerNr = turn_ % players_.size();
-  for (auto building : buildings_) {
-    if (building.getOwner() == nullptr)
-      std::cout << "Building owner of building at " << building.getX() << ", "
-                << building.getY() << " is nullptr" << std::endl;
+  if (journal_) journal_->record(Action());
+  advanceTurn();
+  // Invokes AI players turn. If it's a regular player, this does nothing
+  players_[turn_ % players_.size()]->doTurn();
+}
 
-    if (building.getOwner()->getID() == activePlayerID_) {
-      players_[pastPlayerNr]->modifyResources(building.nextTurn());
-    }
-  }
+void GameState::advanceTurn() {
+  int pastPlayerNr = turn_ % players_.size();
+  players_[pastPlayerNr]->modifyResources(income_[pastPlayerNr]);
   /*
   for (auto army : armies_) {
       if(army.getOwner()->getID() == activePlayerID_){
@@ -108,6 +635,7 @@ void GameState::nextTurn() {
   // Add 1 resource of everything every turn so player cannot softlock itself
   players_[pastPlayerNr]->modifyResources(Resources(1, 1, 1, 1));
   turn_++;
+  commands_.clear();
 
   // Goto next player
   int currentPlayerNr = turn_ % players_.size();
@@ -118,214 +646,176 @@ void GameState::nextTurn() {
     it->setHasCompletedTurn(false);
     it++;
   }
-  // Invokes AI players turn. If it's a regular player, this does nothing
-  players_[currentPlayerNr]->doTurn();
 }
 
 std::vector<std::pair<int, int>> GameState::getVisibleXY(
     std::shared_ptr<Player> player) {
   std::vector<std::pair<int, int>> xyPairs = std::vector<std::pair<int, int>>();
-  std::vector<Tile> tiles = std::vector<Tile>();
-
-  for (auto army : armies_) {
-    if (army.getOwner() != player) continue;
-    int x = army.getLocationX();
-    int y = army.getLocationY();
-    tiles.push_back(getTile(x, y));
-    for (auto tile : getNeighbourTiles(x, y, 1)) {
-      // std::cout << "Adding army visible tile " << tile.getX() << " " <<
-      // tile.getY() << std::endl;
-      tiles.push_back(tile);
-    }
-  }
-  for (auto building : buildings_) {
-    if (building.getOwner() != player) continue;
-    int x = building.getX();
-    int y = building.getY();
-    tiles.push_back(getTile(x, y));
-    for (auto tile : getNeighbourTiles(x, y, 1)) {
-      tiles.push_back(tile);
-    }
-  }
-  for (auto townhall : townhalls_) {
-    if (townhall.getOwner() != player) continue;
-    int x = townhall.getX();
-    int y = townhall.getY();
-    tiles.push_back(getTile(x, y));
-    for (auto tile : getNeighbourTiles(x, y, 1)) {
-      tiles.push_back(tile);
-    }
-  }
-  for (auto mapTile : map_) {
-    if (mapTile.getOwner() != player) continue;
-    int x = mapTile.getX();
-    int y = mapTile.getY();
-    tiles.push_back(getTile(x, y));
-    for (auto tile : getNeighbourTiles(x, y, 1)) {
-      tiles.push_back(tile);
-    }
-  }
+  if (isFogDirty_) updateFogOfWar();
+  PlayerIndex playerIndex = getPlayerIndex(player);
 
-  for (auto tile : tiles) {
-    xyPairs.push_back(tile.getXY());
+  int numTiles = terrain_.size();
+  for (int i = fog_.findNextVisible(playerIndex, 0); i < numTiles;
+       i = fog_.findNextVisible(playerIndex, i + 1)) {
+    xyPairs.push_back(std::make_pair(i / num_rows_, i % num_rows_));
   }
   return xyPairs;
 }
 
+bool GameState::isVisible(std::shared_ptr<Player> player, int x, int y) {
+  if (!areCoordinatesValid(x, y)) return false;
+  if (isFogDirty_) updateFogOfWar();
+  return fog_.isVisible(getPlayerIndex(player), toIndex(x, y));
+}
+
 std::vector<Tile> GameState::getVisibleTiles(std::shared_ptr<Player> player) {
-  std::vector<Tile> tiles = std::vector<Tile>();
-  std::vector<std::pair<int, int>> visibleXY = getVisibleXY(player);
-  std::copy_if(map_.begin(), map_.end(), std::back_inserter(tiles),
-               [visibleXY](Tile tile) {
-                 return std::find(visibleXY.begin(), visibleXY.end(),
-                                  tile.getXY()) != visibleXY.end();
-               });
+  std::vector<Tile> tiles;
+  for (const auto& [x, y] : viewVisibleTiles(player)) {
+    tiles.push_back(getTile(x, y));
+  }
   return tiles;
 };
 
 std::vector<Building> GameState::getVisibleBuildings(
     std::shared_ptr<Player> player) {
-  std::vector<Building> buildings = std::vector<Building>();
-  std::vector<std::pair<int, int>> visibleXY = getVisibleXY(player);
-  std::copy_if(buildings_.begin(), buildings_.end(),
-               std::back_inserter(buildings), [visibleXY](Building building) {
-                 return std::find(visibleXY.begin(), visibleXY.end(),
-                                  building.getXY()) != visibleXY.end();
-               });
-  return buildings;
+  VisibleView<Building> buildings = viewVisibleBuildings(player);
+  return std::vector<Building>(buildings.begin(), buildings.end());
 }
 
 std::vector<TownHall> GameState::getVisibleTownhalls(
     std::shared_ptr<Player> player) {
-  std::vector<TownHall> townhalls = std::vector<TownHall>();
-  std::vector<std::pair<int, int>> visibleXY = getVisibleXY(player);
-  std::copy_if(townhalls_.begin(), townhalls_.end(),
-               std::back_inserter(townhalls), [visibleXY](TownHall townhall) {
-                 return std::find(visibleXY.begin(), visibleXY.end(),
-                                  townhall.getXY()) != visibleXY.end();
-               });
-  return townhalls;
+  VisibleView<TownHall> townhalls = viewVisibleTownhalls(player);
+  return std::vector<TownHall>(townhalls.begin(), townhalls.end());
 }
 
 std::vector<Army> GameState::getVisibleArmies(std::shared_ptr<Player> player) {
-  std::vector<Army> armies = std::vector<Army>();
-  std::vector<std::pair<int, int>> visibleXY = getVisibleXY(player);
-  std::copy_if(armies_.begin(), armies_.end(), std::back_inserter(armies),
-               [visibleXY](Army army) {
-                 return std::find(visibleXY.begin(), visibleXY.end(),
-                                  army.getLocation()) != visibleXY.end();
-               });
-  return armies;
+  VisibleView<Army> armies = viewVisibleArmies(player);
+  return std::vector<Army>(armies.begin(), armies.end());
 }
 
-std::vector<Tile> GameState::getNeighbourTiles(int xPos, int yPos, int radius) {
-  std::vector<Tile> temp;
-
-  if (!areCoordinatesValid(xPos, yPos))
-    throw std::out_of_range("Invalid tile coordinates");
-  for (int xi = xPos - radius; xi <= xPos + radius; xi++) {
-    for (int yi = yPos - radius; yi <= yPos + radius; yi++) {
-      if (areCoordinatesValid(xi, yi) && !(xi == xPos && yi == yPos)) {
-        temp.push_back(getTile(xi, yi));
-      }
-    }
-  }
+VisibleTileView GameState::viewVisibleTiles(
+    const std::shared_ptr<Player>& player) {
+  if (isFogDirty_) updateFogOfWar();
+  return VisibleTileView(fog_, getPlayerIndex(player), terrain_.size(),
+                         num_rows_);
+}
 
-  return temp;
+VisibleView<Building> GameState::viewVisibleBuildings(
+    const std::shared_ptr<Player>& player) {
+  if (isFogDirty_) updateFogOfWar();
+  return VisibleView<Building>(buildings_, fog_, getPlayerIndex(player),
+                               num_rows_);
 }
 
-std::vector<Tile> GameState::getNeighbourGrassTilesNoDiagonal(int xPos,
-                                                              int yPos,
-                                                              int radius) {
-  std::vector<Tile> temp;
+VisibleView<TownHall> GameState::viewVisibleTownhalls(
+    const std::shared_ptr<Player>& player) {
+  if (isFogDirty_) updateFogOfWar();
+  return VisibleView<TownHall>(townhalls_, fog_, getPlayerIndex(player),
+                               num_rows_);
+}
 
-  if (!areCoordinatesValid(xPos, yPos))
-    throw std::out_of_range("Invalid tile coordinates");
+VisibleView<Army> GameState::viewVisibleArmies(
+    const std::shared_ptr<Player>& player) {
+  if (isFogDirty_) updateFogOfWar();
+  return VisibleView<Army>(armies_.values(), fog_, getPlayerIndex(player),
+                           num_rows_);
+}
 
-  for (int xi = xPos - radius; xi <= xPos + radius; xi++) {
-    for (int yi = yPos - radius; yi <= yPos + radius; yi++) {
-      // Only include tiles that are horizontally or vertically adjacent within
-      // the radius
-      if ((xi == xPos || yi == yPos) && !(xi == xPos && yi == yPos) &&
-          areCoordinatesValid(xi, yi) && getTile(xi, yi).getType() == GRASS) {
-        temp.push_back(getTile(xi, yi));
-      }
-    }
+const FlowField& GameState::getFlowField(int targetX, int targetY,
+                                        MovementClass movement) {
+  if (!areCoordinatesValid(targetX, targetY))
+    throw std::out_of_range("Invalid target coordinates");
+
+  int key = toIndex(targetX, targetY) * NUM_MOVEMENT_CLASSES + movement;
+  auto it = flowFields_.find(key);
+  if (it == flowFields_.end()) {
+    it = flowFields_
+             .emplace(key, FlowField(terrain_, num_rows_, targetX, targetY,
+                                     movement))
+             .first;
   }
+  return it->second;
+}
 
-  return temp;
+bool GameState::canReach(MovementClass movement, int fromX, int fromY,
+                         int toX, int toY) const {
+  if (!areCoordinatesValid(fromX, fromY) || !areCoordinatesValid(toX, toY))
+    return false;
+  return components_.isConnected(movement, toIndex(fromX, fromY),
+                                 toIndex(toX, toY));
 }
 
-// Yoinked Junya's implementation
 std::vector<TownHall>::iterator GameState::findTownhallByLocation(int x,
                                                                   int y) {
-  return std::find_if(
-      townhalls_.begin(), townhalls_.end(),
-      [x, y](const TownHall& a) { return a.getX() == x && a.getY() == y; });
+  if (!areCoordinatesValid(x, y)) return townhalls_.end();
+
+  int index = townhallGrid_[toIndex(x, y)];
+  if (index == -1) return townhalls_.end();
+  return townhalls_.begin() + index;
 }
 
 TownHall& GameState::getTownhallByLocation(int x, int y) {
   if (!areCoordinatesValid(x, y))
     throw std::out_of_range("Invalid tile coordinates");
 
-  auto it = townhalls_.begin();
-  while (it != townhalls_.end()) {
-    if (it->getX() == x && it->getY() == y) return *it;
-    it++;
-  }
-  throw std::invalid_argument("No townhall is located on the tile");
+  auto it = findTownhallByLocation(x, y);
+  if (it == townhalls_.end())
+    throw std::invalid_argument("No townhall is located on the tile");
+  return *it;
 }
 
-std::shared_ptr<Player> GameState::getTownhallOwner(int x, int y) {
-  auto it = std::find_if(
-      townhalls_.begin(), townhalls_.end(),
-      [x, y](const TownHall& a) { return a.getX() == x && a.getY() == y; });
+PlayerIndex GameState::getTownhallOwner(int x, int y) {
+  auto it = findTownhallByLocation(x, y);
 
   if (it != townhalls_.end()) {
     return it->getOwner();
   }
-  return nullptr;
+  return NO_PLAYER;
 }
 
 bool GameState::tileHasTownhall(int x, int y) {
   return findTownhallByLocation(x, y) != townhalls_.end() &&
-         getTownhallOwner(x, y)->getID() == activePlayerID_;
+         getPlayer(getTownhallOwner(x, y))->getID() == activePlayerID_;
 }
 
 void GameState::placeSoldiers(std::shared_ptr<Player> player,
                               ArmyType armyType) {
-  std::pair<int, int> TWCoords;
-  TownHall currentTW =
-      townhalls_[0];  // bad temp I know but it be like that sometimes
-  for (auto Townhall : townhalls_) {
-    if (Townhall.getOwner()->getID() == player->getID()) {
-      TWCoords = Townhall.getPosition();
-    }
+  PlayerIndex playerIndex = getPlayerIndex(player);
+  auto townhallIt = std::find_if(
+      townhalls_.begin(), townhalls_.end(),
+      [playerIndex](const TownHall& t) { return t.getOwner() == playerIndex; });
+  if (townhallIt == townhalls_.end())
+    throw std::invalid_argument("The player has no townhall");
+  if (journal_) {
+    Action action;
+    action.type = PLACE_SOLDIERS;
+    action.player = playerIndex;
+    action.unitType = armyType;
+    journal_->record(action);
   }
+  std::pair<int, int> TWCoords = townhallIt->getPosition();
 
   // Check if player has enough resources to place an army
-  if (!currentTW.canRecruitSoldier(player->getResources(), armyType)) return;
+  if (!townhallIt->canRecruitSoldier(player->getResources(), armyType)) return;
   Resources cost = getArmyDeploymentCost(armyType);
-  Resources costNeg =
-      Resources(-cost.food, -cost.wood, -cost.gold, -cost.stone);
-
-  std::vector<Tile> TWNeigbours =
-      getNeighbourTiles(TWCoords.first, TWCoords.second, 1);
 
   // Army merge logic
-  for (auto Tile : TWNeigbours) {
-    if (tileHasArmy(Tile.getX(), Tile.getY())) {
-      Army& army = getArmyByLocation(Tile.getX(), Tile.getY());
-      std::shared_ptr<Player> armyOwner = army.getOwner();
-      if (armyOwner == player && army.getType() == armyType) {
+  for (const GridOffset& offset : NEIGHBOUR_OFFSETS<EIGHT_CONNECTED, 1>) {
+    int x = TWCoords.first + offset.dx;
+    int y = TWCoords.second + offset.dy;
+    if (!areCoordinatesValid(x, y)) continue;
+    if (tileHasArmy(x, y)) {
+      Army& army = getArmyByLocation(x, y);
+      if (army.getOwner() == playerIndex && army.getType() == armyType) {
         // Army merges
+        recordArmyState(army);
         army.incrementUnitCount();
-        player->modifyResources(costNeg);
+        chargePlayer(playerIndex, cost);
         break;
       }
-    } else if (Tile.getType() == GRASS) {
-      addArmy(armyType, Tile.getX(), Tile.getY(), player, 1);
-      player->modifyResources(costNeg);
+    } else if (getTileType(x, y) == GRASS) {
+      addArmy(armyType, x, y, playerIndex, 1);
+      chargePlayer(playerIndex, cost);
       break;
     }
   }
@@ -335,143 +825,135 @@ Army& GameState::getArmyByLocation(int x, int y) {
   if (!areCoordinatesValid(x, y))
     throw std::out_of_range("Invalid tile coordinates");
 
-  auto it = armies_.begin();
-  while (it != armies_.end()) {
-    if (it->getLocationX() == x && it->getLocationY() == y) return *it;
-    it++;
-  }
-  throw std::invalid_argument("No army is located on the tile");
+  Army* army = armies_.get(findArmyByLocation(x, y));
+  if (army == nullptr)
+    throw std::invalid_argument("No army is located on the tile");
+  return *army;
 }
 
-std::vector<Army>::iterator GameState::findArmyByLocation(int x, int y) {
-  return std::find_if(armies_.begin(), armies_.end(), [x, y](const Army& a) {
-    // std::cout << a.getLocationX() << "==" << x << "&&" << a.getLocationY() <<
-    // "==" << y << std::endl;
-    return a.getLocationX() == x && a.getLocationY() == y;
-  });
+ArmyHandle GameState::findArmyByLocation(int x, int y) const {
+  if (!areCoordinatesValid(x, y)) return ArmyHandle();
+  return armyGrid_[toIndex(x, y)];
 }
 
+Army* GameState::getArmy(ArmyHandle handle) { return armies_.get(handle); }
+
 bool GameState::tileHasArmy(int x, int y) {
-  return findArmyByLocation(x, y) != armies_.end();
+  return armies_.contains(findArmyByLocation(x, y));
 }
 
-std::vector<std::pair<int, int>> GameState::getArmyMovementRange(Army& army) {
-  std::vector<std::pair<int, int>> locations;
-  int speed = 1;
+MovementRange GameState::getMovementRange(const Army& army) {
   int x0 = army.getLocationX();
   int y0 = army.getLocationY();
+  if (!areCoordinatesValid(x0, y0)) return MovementRange();
+
+  PlayerIndex armyOwner = army.getOwner();
+  ArmyType armyType = army.getType();
+  MovementClass movement = getMovementClass(armyType);
+
+  auto stepCost = [&](int fromX, int fromY, int toX, int toY) {
+    int to = toIndex(toX, toY);
+    if (!canTraverse(movement, static_cast<TileType>(terrain_[to])))
+      return -1;
+
+    // Army cannot move from an enemy's tile to the same enemy's tile
+    PlayerIndex tileOwner = owners_[to];
+    if (tileOwner != armyOwner && tileOwner != NO_PLAYER &&
+        owners_[toIndex(fromX, fromY)] == tileOwner)
+      return -1;
+
+    const Army* armyOnTile = armies_.get(armyGrid_[to]);
+    if (armyOnTile && armyOnTile->getOwner() == armyOwner &&
+        armyOnTile->getType() != armyType)
+      return -1;
+
+    return 1;
+  };
+  auto stopsAt = [&](int x, int y) { return tileHasArmy(x, y); };
+
+  return MovementRange(x0, y0, army.getSpeed(), getNumCols(), num_rows_,
+                       stepCost, stopsAt);
+}
 
-  if (army.getHasCompletedTurn()) return locations;
-
-  for (int xOffset = -speed; xOffset <= speed; xOffset++) {
-    int offsetRemainder = speed - abs(xOffset);
-    for (int yOffset = -offsetRemainder; yOffset <= offsetRemainder;
-         yOffset++) {
-      int x = x0 + xOffset;
-      int y = y0 + yOffset;
-      if (isArmyWithinMovementRange(army, x, y)) {
-        locations.push_back(std::make_pair(x, y));
-      }
-    }
-  }
-
-  return locations;
+std::vector<std::pair<int, int>> GameState::getArmyMovementRange(Army& army) {
+  if (army.getHasCompletedTurn()) return std::vector<std::pair<int, int>>();
+  return getMovementRange(army).getTiles();
 }
 
 bool GameState::isArmyWithinMovementRange(Army& army, int x, int y) {
-  int speed = 1;
-
   if (!areCoordinatesValid(x, y)) return false;
-
-  int x0 = army.getLocationX();
-  int y0 = army.getLocationY();
-
-  if (x == x0 && y == y0) return false;
-
-  int xOffset = x - x0;
-  int yOffset = y - y0;
-  if (abs(xOffset) + abs(yOffset) > speed) return false;
-
-  Tile& tile = getTile(x, y);
-  if (!army.canAdvance(tile.getType())) return false;
-
-  std::shared_ptr<Player> armyOwner = army.getOwner();
-  std::shared_ptr<Player> tileOwner = tile.getOwner();
-
-  // Army cannot move from an enemy's tile to the same enemy's tile
-  if (armyOwner != tileOwner && tileOwner &&
-      getTile(x0, y0).getOwner() == tileOwner)
-    return false;
-
-  if (tileHasArmy(x, y)) {
-    Army& armyOnTile = getArmyByLocation(x, y);
-    if (armyOnTile.getOwner() == army.getOwner() &&
-        armyOnTile.getType() != army.getType()) {
-      return false;
-    }
-  }
-
-  return true;
+  return getMovementRange(army).contains(x, y);
 }
 
 void GameState::moveArmy(Army& army, int x, int y) {
   if (!areCoordinatesValid(x, y))
     throw std::out_of_range("Invalid tile coordinates");
+  if (journal_) {
+    Action action;
+    action.type = MOVE_ARMY;
+    action.x = army.getLocationX();
+    action.y = army.getLocationY();
+    action.toX = x;
+    action.toY = y;
+    journal_->record(action);
+  }
 
-  std::shared_ptr<Player> armyOwner = army.getOwner();
-  Tile& tile = getTile(x, y);
-  std::shared_ptr<Player> tileOwner = tile.getOwner();
-  TileType tileType = tile.getType();
-  auto armyOnTileIt = findArmyByLocation(x, y);
-  int x0 = army.getLocationX();
-  int y0 = army.getLocationY();
+  PlayerIndex armyOwner = army.getOwner();
+  ArmyHandle self = findArmyByLocation(army.getLocationX(),
+                                       army.getLocationY());
+  ArmyHandle other = findArmyByLocation(x, y);
+  Army* otherArmy = armies_.get(other);
 
   if (isArmyWithinMovementRange(army, x, y)) {
-    if (armyOnTileIt == armies_.end()) {
+    if (otherArmy == nullptr) {
       // Army moves
-      army.setLocation(std::make_pair(x, y));
+      recordArmyState(army);
+      setArmyLocation(army, x, y);
       army.setHasCompletedTurn(true);
     } else {
-      std::shared_ptr<Player> otherArmyOwner = armyOnTileIt->getOwner();
+      PlayerIndex otherArmyOwner = otherArmy->getOwner();
       int ownUnitCount = army.getUnitCount();
-      int otherUnitCount = armyOnTileIt->getUnitCount();
+      int otherUnitCount = otherArmy->getUnitCount();
+      // Erasing the other army may move this one in memory, so it is looked up
+      // again through its handle afterwards
       if (otherArmyOwner == armyOwner) {
         // Army merges
-        army.setLocation(std::make_pair(x, y));
-        army.setUnitCount(ownUnitCount + otherUnitCount);
-        army.setHasCompletedTurn(true);
-        armies_.erase(armyOnTileIt);
+        eraseArmy(other);
+        Army& mergedArmy = *armies_.get(self);
+        recordArmyState(mergedArmy);
+        setArmyLocation(mergedArmy, x, y);
+        mergedArmy.setUnitCount(ownUnitCount + otherUnitCount);
+        mergedArmy.setHasCompletedTurn(true);
       } else {
         // Combat
         int enemyCasualty = std::round(ownUnitCount * army.getAttack() /
-                                       armyOnTileIt->getDefense() * .6);
-        int ownCasualty =
-            std::round(otherUnitCount * armyOnTileIt->getAttack() /
-                       army.getDefense() * .7);
+                                       otherArmy->getDefense() * .6);
+        int ownCasualty = std::round(otherUnitCount * otherArmy->getAttack() /
+                                     army.getDefense() * .7);
         ownUnitCount = std::max(ownUnitCount - ownCasualty, 0);
         otherUnitCount = std::max(otherUnitCount - enemyCasualty, 0);
+        recordArmyState(army);
+        recordArmyState(*otherArmy);
         army.setUnitCount(ownUnitCount);
-        armyOnTileIt->setUnitCount(otherUnitCount);
+        otherArmy->setUnitCount(otherUnitCount);
 
         bool isSelfAlive = ownUnitCount > 0;
         bool isEnemyAlive = otherUnitCount > 0;
 
         if (isSelfAlive && !isEnemyAlive) {
           // Victory
-          army.setLocation(std::make_pair(x, y));
-          army.setHasCompletedTurn(true);
-          armies_.erase(armyOnTileIt);
+          eraseArmy(other);
+          Army& victoriousArmy = *armies_.get(self);
+          setArmyLocation(victoriousArmy, x, y);
+          victoriousArmy.setHasCompletedTurn(true);
         } else if (!isSelfAlive && isEnemyAlive) {
           // Defeat
-          auto armyIt = findArmyByLocation(x0, y0);
-          armies_.erase(armyIt);
+          eraseArmy(self);
         } else {
           // Draw
           if (!isSelfAlive && !isEnemyAlive) {
-            armies_.erase(armyOnTileIt);
-
-            auto armyIt = findArmyByLocation(x0, y0);
-            armies_.erase(armyIt);
+            eraseArmy(other);
+            eraseArmy(self);
           } else {
             army.setHasCompletedTurn(true);
           }
@@ -484,56 +966,81 @@ void GameState::moveArmy(Army& army, int x, int y) {
 void GameState::colonize(Army& army) {
   int x = army.getLocationX();
   int y = army.getLocationY();
-  std::shared_ptr<Player> player = army.getOwner();
+  // Capturing a townhall erases the loser's armies, which moves this one
+  ArmyHandle self = findArmyByLocation(x, y);
+  if (journal_) {
+    Action action;
+    action.type = COLONIZE;
+    action.x = x;
+    action.y = y;
+    journal_->record(action);
+  }
+  PlayerIndex player = army.getOwner();
 
-  Tile& tile = getTile(x, y);
-  std::shared_ptr<Player> tileOwner = tile.getOwner();
+  PlayerIndex tileOwner = getTileOwner(x, y);
   auto buildingIt = findBuildingByLocation(x, y);
 
-  auto it = std::find_if(players_.begin(), players_.end(),
-                         [&tileOwner](const std::shared_ptr<Player>& player) {
-                           return player == tileOwner;
-                         });
-  if (it == players_.end()) {
-    tile.setOwner(player);
+  if (getPlayer(tileOwner) == nullptr) {
+    setTileOwner(x, y, player);
   } else {
-    std::cout << "If tileOwner == player return" << std::endl;
     if (tileOwner == player) return;
     auto townhallIt = findTownhallByLocation(x, y);
     if (townhallIt != townhalls_.end()) {
-      std::cout << "If townhallowner == player return" << std::endl;
-      std::shared_ptr<Player> townhallOwner = townhallIt->getOwner();
+      PlayerIndex townhallOwner = townhallIt->getOwner();
       if (townhallOwner == player) return;
       handleGameover(townhallOwner);
     } else {
-      tile.setOwner(nullptr);
+      setTileOwner(x, y, NO_PLAYER);
       if (buildingIt != buildings_.end()) {
-        buildings_.erase(buildingIt);
+        eraseBuilding(buildingIt - buildings_.begin());
       }
     }
   }
-  army.setHasCompletedTurn(true);
+  Army* colonizer = armies_.get(self);
+  recordArmyState(*colonizer);
+  colonizer->setHasCompletedTurn(true);
 }
 
-std::vector<std::reference_wrapper<Army>> GameState::getPlayerArmies(
+std::vector<ArmyHandle> GameState::getPlayerArmies(
     std::shared_ptr<Player> player) {
-  std::vector<std::reference_wrapper<Army>> playerArmies;
-  for (Army& a : armies_) {  // Use reference here
-    if (a.getOwner() == player) playerArmies.push_back(a);
+  std::vector<ArmyHandle> playerArmies;
+  PlayerIndex playerIndex = getPlayerIndex(player);
+  for (int i = 0; i < armies_.size(); i++) {
+    if (armies_[i].getOwner() == playerIndex)
+      playerArmies.push_back(armies_.handleAt(i));
   }
   return playerArmies;
 }
 
+const std::vector<Building>& GameState::getBuildings() const {
+  return buildings_;
+}
+
+const std::vector<TownHall>& GameState::getTownhalls() const {
+  return townhalls_;
+}
+
 bool GameState::areCoordinatesValid(int x, int y) const {
-  int idx = x * num_rows_ + y;
-  return idx >= 0 && idx < map_.size() && y < num_rows_ && x >= 0 && y >= 0;
+  int idx = toIndex(x, y);
+  return idx >= 0 && idx < static_cast<int>(terrain_.size()) &&
+         y < num_rows_ && x >= 0 && y >= 0;
 }
 
+int GameState::toIndex(int x, int y) const { return x * num_rows_ + y; }
+
+int GameState::getNumCols() const {
+  return num_rows_ > 0 ? terrain_.size() / num_rows_ : 0;
+}
+
+int GameState::getNumRows() const { return num_rows_; }
+
 std::vector<Building>::iterator GameState::findBuildingByLocation(int x,
                                                                   int y) {
-  return std::find_if(
-      buildings_.begin(), buildings_.end(),
-      [x, y](const Building& b) { return b.getX() == x && b.getY() == y; });
+  if (!areCoordinatesValid(x, y)) return buildings_.end();
+
+  int index = buildingGrid_[toIndex(x, y)];
+  if (index == -1) return buildings_.end();
+  return buildings_.begin() + index;
 }
 
 bool GameState::tileHasBuilding(int x, int y) {
@@ -545,9 +1052,9 @@ bool GameState::canPlaceBuilding(int x, int y, int playerID) {
     return false;
   }
 
-  Tile& tile = getTile(x, y);
+  const std::shared_ptr<Player>& owner = getPlayer(getTileOwner(x, y));
 
-  if (tile.getOwner() == nullptr || tile.getOwner()->getID() != playerID) {
+  if (owner == nullptr || owner->getID() != playerID) {
     return false;
   }
 
@@ -558,18 +1065,17 @@ bool GameState::canPlaceBuilding(int x, int y, int playerID) {
   return true;
 }
 
-void GameState::handleGameover(std::shared_ptr<Player> player) {
-  std::cout << "Player " << player->getID() << " lost" << std::endl;
-  player->setIsAlive(false);
+void GameState::handleGameover(PlayerIndex player) {
+  getPlayer(player)->setIsAlive(false);
+  if (undoSteps_)
+    undoSteps_->push_back(
+        [this, player] { getPlayer(player)->setIsAlive(true); });
 
-  auto tileIt = map_.begin();
-
-  while (tileIt != map_.end()) {
-    std::shared_ptr<Player> tileOwner = tileIt->getOwner();
-    if (tileOwner && tileOwner->getID() == player->getID()) {
-      tileIt->setOwner(nullptr);
+  if (player < ownedTiles_.size()) {
+    while (!ownedTiles_[player].empty()) {
+      int i = ownedTiles_[player].back();
+      setTileOwner(i / num_rows_, i % num_rows_, NO_PLAYER);
     }
-    tileIt++;
   }
 
   destroyArmiesByPlayer(player);
@@ -591,28 +1097,45 @@ std::shared_ptr<Player> GameState::getWinner() const {
   return winnerCandidate;
 }
 
-void GameState::destroyArmiesByPlayer(std::shared_ptr<Player> player) {
-  std::vector<Army> newArmies;
-  std::copy_if(armies_.begin(), armies_.end(), std::back_inserter(newArmies),
-               [player](Army& army) {
-                 std::shared_ptr<Player> owner = army.getOwner();
-                 return owner && owner->getID() == player->getID();
-               });
-  armies_ = newArmies;
+void GameState::destroyArmiesByPlayer(PlayerIndex player) {
+  // Iterate backwards, erasing only ever moves an already visited army
+  for (int i = armies_.size() - 1; i >= 0; i--) {
+    if (armies_[i].getOwner() == player) eraseArmy(armies_.handleAt(i));
+  }
 }
 
-void GameState::destroyBuildingsByPlayer(std::shared_ptr<Player> player) {
-  std::vector<Building> newBuildings;
-  std::copy_if(buildings_.begin(), buildings_.end(),
-               std::back_inserter(newBuildings), [player](Building& building) {
-                 std::shared_ptr<Player> owner = building.getOwner();
-                 return owner && owner->getID() == player->getID();
-               });
-  buildings_ = newBuildings;
+void GameState::destroyBuildingsByPlayer(PlayerIndex player) {
+  if (undoSteps_) {
+    undoSteps_->push_back([this, buildings = buildings_] {
+      buildings_ = buildings;
+      rebuildOccupancy();
+      rebuildIncome();
+      isFogDirty_ = true;
+      markMapChanged();
+    });
+  }
+  for (const Building& building : buildings_) {
+    if (building.getOwner() != player) continue;
+    removeVisionSource(player, building.getX(), building.getY());
+    updateIncome(building, -1);
+  }
+  buildings_.erase(std::remove_if(buildings_.begin(), buildings_.end(),
+                                  [player](const Building& building) {
+                                    return building.getOwner() == player;
+                                  }),
+                   buildings_.end());
+  rebuildOccupancy();
 }
 
 void GameState::incrementArmyUnit(Army& army) {
-  std::shared_ptr<Player> player = army.getOwner();
+  if (journal_) {
+    Action action;
+    action.type = INCREMENT_ARMY_UNIT;
+    action.x = army.getLocationX();
+    action.y = army.getLocationY();
+    journal_->record(action);
+  }
+  const std::shared_ptr<Player>& player = getPlayer(army.getOwner());
   Resources resources = player->getResources();
   Resources cost = getArmyDeploymentCost(army.getType());
 
@@ -621,8 +1144,244 @@ void GameState::incrementArmyUnit(Army& army) {
   if (resources.gold < cost.gold) return;
   if (resources.stone < cost.stone) return;
 
-  Resources costNeg =
-      Resources(-cost.food, -cost.wood, -cost.gold, -cost.stone);
-  player->modifyResources(costNeg);
+  chargePlayer(army.getOwner(), cost);
+  recordArmyState(army);
   army.incrementUnitCount();
-}
\ No newline at end of file
+}
+
+void GameState::rebuildOccupancy() {
+  townhallGrid_.assign(terrain_.size(), -1);
+  buildingGrid_.assign(terrain_.size(), -1);
+  armyGrid_.assign(terrain_.size(), ArmyHandle());
+
+  // Iterate backwards such that the first entity on a tile wins, like the
+  // linear searches this index replaces
+  for (int i = townhalls_.size() - 1; i >= 0; i--) {
+    int x = townhalls_[i].getX();
+    int y = townhalls_[i].getY();
+    if (areCoordinatesValid(x, y)) townhallGrid_[toIndex(x, y)] = i;
+  }
+  for (int i = buildings_.size() - 1; i >= 0; i--) {
+    int x = buildings_[i].getX();
+    int y = buildings_[i].getY();
+    if (areCoordinatesValid(x, y)) buildingGrid_[toIndex(x, y)] = i;
+  }
+  for (int i = armies_.size() - 1; i >= 0; i--) {
+    int x = armies_[i].getLocationX();
+    int y = armies_[i].getLocationY();
+    if (areCoordinatesValid(x, y))
+      armyGrid_[toIndex(x, y)] = armies_.handleAt(i);
+  }
+}
+
+void GameState::eraseArmy(ArmyHandle handle) {
+  Army* army = armies_.get(handle);
+  if (army == nullptr) return;
+
+  int x = army->getLocationX();
+  int y = army->getLocationY();
+  if (areCoordinatesValid(x, y) && armyGrid_[toIndex(x, y)] == handle)
+    armyGrid_[toIndex(x, y)] = ArmyHandle();
+  removeVisionSource(army->getOwner(), x, y);
+  if (undoSteps_)
+    undoSteps_->push_back(
+        [this, handle, army = *army] { restoreArmy(handle, army); });
+
+  armies_.erase(handle);
+}
+
+void GameState::restoreArmy(ArmyHandle handle, const Army& army) {
+  armies_.restore(handle, army);
+  int x = army.getLocationX();
+  int y = army.getLocationY();
+  if (areCoordinatesValid(x, y) && !tileHasArmy(x, y))
+    armyGrid_[toIndex(x, y)] = handle;
+  addVisionSource(army.getOwner(), x, y);
+}
+
+void GameState::eraseBuilding(int index) {
+  int cell = toIndex(buildings_[index].getX(), buildings_[index].getY());
+  if (buildingGrid_[cell] == index) buildingGrid_[cell] = -1;
+  removeVisionSource(buildings_[index].getOwner(), buildings_[index].getX(),
+                     buildings_[index].getY());
+  updateIncome(buildings_[index], -1);
+  if (undoSteps_)
+    undoSteps_->push_back([this, index, building = buildings_[index]] {
+      insertBuilding(index, building);
+    });
+
+  buildings_.erase(buildings_.begin() + index);
+
+  // Every building behind the erased one moved down by one position
+  for (size_t i = index; i < buildings_.size(); i++) {
+    buildingGrid_[toIndex(buildings_[i].getX(), buildings_[i].getY())] = i;
+  }
+}
+
+void GameState::insertBuilding(int index, const Building& building) {
+  buildings_.insert(buildings_.begin() + index, building);
+  // Every building behind the inserted one moved up by one position
+  for (size_t i = index + 1; i < buildings_.size(); i++) {
+    buildingGrid_[toIndex(buildings_[i].getX(), buildings_[i].getY())] = i;
+  }
+  int cell = toIndex(building.getX(), building.getY());
+  if (buildingGrid_[cell] == -1) buildingGrid_[cell] = index;
+  addVisionSource(building.getOwner(), building.getX(), building.getY());
+  updateIncome(building, 1);
+}
+
+void GameState::updateIncome(const Building& building, int sign) {
+  PlayerIndex owner = building.getOwner();
+  if (owner >= income_.size()) return;
+
+  Resources gain = building.nextTurn();
+  income_[owner].food += sign * gain.food;
+  income_[owner].wood += sign * gain.wood;
+  income_[owner].gold += sign * gain.gold;
+  income_[owner].stone += sign * gain.stone;
+  buildingCounts_[owner][building.getType()] += sign;
+}
+
+void GameState::rebuildIncome() {
+  income_.assign(players_.size(), Resources(0, 0, 0, 0));
+  buildingCounts_.assign(players_.size(), {});
+  for (const Building& building : buildings_) {
+    updateIncome(building, 1);
+  }
+}
+
+void GameState::updateFogOfWar() {
+  fog_.reset(players_.size(), terrain_.size());
+  isFogDirty_ = false;
+  markMapChanged();
+
+  for (const Army& army : armies_) {
+    addVisionSource(army.getOwner(), army.getLocationX(), army.getLocationY());
+  }
+  for (const Building& building : buildings_) {
+    addVisionSource(building.getOwner(), building.getX(), building.getY());
+  }
+  for (const TownHall& townhall : townhalls_) {
+    addVisionSource(townhall.getOwner(), townhall.getX(), townhall.getY());
+  }
+  int numTiles = owners_.size();
+  for (int i = 0; i < numTiles; i++) {
+    if (owners_[i] == NO_PLAYER) continue;
+    addVisionSource(owners_[i], i / num_rows_, i % num_rows_);
+  }
+}
+
+void GameState::addVisionSource(PlayerIndex player, int x, int y) {
+  // A dirty fog of war gets recomputed from scratch on the next query anyway
+  if (isFogDirty_ || player >= players_.size() || !areCoordinatesValid(x, y))
+    return;
+
+  if (fog_.addViewer(player, toIndex(x, y))) markTileChanged(toIndex(x, y));
+  forEachNeighbour<EIGHT_CONNECTED>(x, y, [&](int xi, int yi) {
+    if (fog_.addViewer(player, toIndex(xi, yi)))
+      markTileChanged(toIndex(xi, yi));
+  });
+}
+
+void GameState::removeVisionSource(PlayerIndex player, int x, int y) {
+  if (isFogDirty_ || player >= players_.size() || !areCoordinatesValid(x, y))
+    return;
+
+  if (fog_.removeViewer(player, toIndex(x, y)))
+    markTileChanged(toIndex(x, y));
+  forEachNeighbour<EIGHT_CONNECTED>(x, y, [&](int xi, int yi) {
+    if (fog_.removeViewer(player, toIndex(xi, yi)))
+      markTileChanged(toIndex(xi, yi));
+  });
+}
+
+void GameState::setTileOwner(int x, int y, PlayerIndex player) {
+  int index = toIndex(x, y);
+  PlayerIndex& owner = owners_[index];
+  if (owner == player) return;
+
+  if (owner < ownedTiles_.size()) {
+    // Swap the tile with the last one of the list and pop it
+    std::vector<int>& tiles = ownedTiles_[owner];
+    int pos = ownedTilePos_[index];
+    tiles[pos] = tiles.back();
+    ownedTilePos_[tiles[pos]] = pos;
+    tiles.pop_back();
+    ownedTilePos_[index] = -1;
+  }
+  if (player < ownedTiles_.size()) {
+    ownedTilePos_[index] = ownedTiles_[player].size();
+    ownedTiles_[player].push_back(index);
+  }
+
+  if (undoSteps_) {
+    PlayerIndex oldOwner = owner;
+    undoSteps_->push_back(
+        [this, x, y, oldOwner] { setTileOwner(x, y, oldOwner); });
+  }
+  removeVisionSource(owner, x, y);
+  owner = player;
+  addVisionSource(player, x, y);
+  markTileChanged(index);
+}
+
+void GameState::rebuildOwnedTiles() {
+  ownedTiles_.assign(players_.size(), std::vector<int>());
+  ownedTilePos_.assign(owners_.size(), -1);
+
+  int numTiles = owners_.size();
+  for (int i = 0; i < numTiles; i++) {
+    if (owners_[i] >= ownedTiles_.size()) continue;
+    ownedTilePos_[i] = ownedTiles_[owners_[i]].size();
+    ownedTiles_[owners_[i]].push_back(i);
+  }
+}
+
+void GameState::markTileChanged(int index) {
+  // Past the size of the map, redrawing everything is cheaper than keeping
+  // the list
+  if (mapChanges_.size() >= terrain_.size()) {
+    markMapChanged();
+    return;
+  }
+  mapChanges_.push_back(index);
+  mapRevision_++;
+}
+
+void GameState::markMapChanged() {
+  mapChanges_.clear();
+  mapRevision_++;
+  mapChangesBase_ = mapRevision_;
+}
+
+void GameState::onMapLoaded() {
+  rebuildOccupancy();
+  rebuildOwnedTiles();
+  flowFields_.clear();
+  components_.build(terrain_, num_rows_);
+  isFogDirty_ = true;
+  markMapChanged();
+  commands_.clear();
+}
+
+void GameState::setArmyLocation(Army& army, int x, int y) {
+  int from = toIndex(army.getLocationX(), army.getLocationY());
+  int to = toIndex(x, y);
+  if (undoSteps_) {
+    ArmyHandle handle = armyGrid_[from];
+    int fromX = army.getLocationX();
+    int fromY = army.getLocationY();
+    undoSteps_->push_back([this, handle, fromX, fromY] {
+      setArmyLocation(*armies_.get(handle), fromX, fromY);
+    });
+  }
+
+  removeVisionSource(army.getOwner(), army.getLocationX(),
+                     army.getLocationY());
+  army.setLocation(std::make_pair(x, y));
+  addVisionSource(army.getOwner(), x, y);
+
+  armyGrid_[to] = armyGrid_[from];
+  armyGrid_[from] = ArmyHandle();
+}
+
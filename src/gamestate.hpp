@@ -1,25 +1,79 @@
 #ifndef SRC_GAMESTATE_HPP_
 #define SRC_GAMESTATE_HPP_
 
-#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "army.hpp"
 #include "building.hpp"
+#include "commandlog.hpp"
+#include "connectedcomponents.hpp"
+#include "flowfield.hpp"
+#include "fogofwar.hpp"
+#include "grid.hpp"
+#include "journal.hpp"
+#include "mapfile.hpp"
+#include "mappedmap.hpp"
+#include "movementrange.hpp"
 #include "player.hpp"
+#include "random.hpp"
+#include "slotmap.hpp"
+#include "snapshot.hpp"
 #include "tile.hpp"
 #include "townhall.hpp"
+#include "visibleview.hpp"
+
+// Stable reference to an army, survives moves, merges and combat of others
+using ArmyHandle = SlotMap<Army>::Handle;
 
 class GameState {
  public:
   /**
    * @brief Construct a new Game State object
    *
-   * @param window
+   * The match is seeded from std::random_device, call setSeed to replay a
+   * match.
+   *
    * @param turn
    */
-  GameState(std::shared_ptr<sf::RenderWindow> window, int turn = 1);
+  GameState(int turn = 1);
+
+  /**
+   * @brief Seed all random decisions of the match
+   *
+   * Restarts the random stream of every player. A match started with the same
+   * seed, map and players plays out the same way.
+   *
+   * @param seed
+   */
+  void setSeed(uint64_t seed);
+
+  /**
+   * @brief Get the seed of the match
+   *
+   * @return uint64_t
+   */
+  uint64_t getSeed() const;
+
+  /**
+   * @brief Get the random stream of a player
+   *
+   * Every player draws from its own stream, so what one player does with its
+   * random numbers does not change those of the others.
+   *
+   * @param player
+   * @return Random&
+   * @throws std::out_of_range if the player is not part of the game
+   */
+  Random& getRandom(PlayerIndex player);
 
   /**
    * @brief Tick function to trigger AI actions
@@ -28,12 +82,30 @@ class GameState {
   void tick();
 
   /**
-   * @brief Adds a player to Game State
+   * @brief Adds a player to Game State and assigns its PlayerIndex
    *
    * @param player
+   * @throws std::length_error if the game already has the maximum number of
+   * players
    */
   void addPlayer(std::shared_ptr<Player> player);
 
+  /**
+   * @brief Resolves a PlayerIndex back to the player it belongs to
+   *
+   * @param index
+   * @return const std::shared_ptr<Player>&, nullptr for NO_PLAYER
+   */
+  const std::shared_ptr<Player>& getPlayer(PlayerIndex index) const;
+
+  /**
+   * @brief Get the index of a player in this game
+   *
+   * @param player
+   * @return PlayerIndex, NO_PLAYER if the player is not part of the game
+   */
+  PlayerIndex getPlayerIndex(const std::shared_ptr<Player>& player) const;
+
   /**
    * @brief Get the Active Player ID
    *
@@ -41,6 +113,38 @@ class GameState {
    */
   int getActivePlayerID();
 
+  /**
+   * @brief Get the number of the current turn
+   *
+   * Starts at the value passed to the constructor and increases by one every
+   * time a player ends their turn.
+   *
+   * @return int
+   */
+  int getTurn() const;
+
+  /**
+   * @brief Get a counter that changes whenever the terrain, the owner of a
+   * tile or the visibility of a tile for any player changed
+   *
+   * Renderers compare it to the value they last drew with, and only redraw
+   * the map when it differs.
+   *
+   * @return uint64_t
+   */
+  uint64_t getMapRevision() const;
+
+  /**
+   * @brief Get the tiles that changed since a map revision
+   *
+   * @param revision an earlier result of getMapRevision
+   * @param tiles set to the indices of the changed tiles, see toIndex. A tile
+   * may be listed more than once.
+   * @return false if the revision is too old to tell, e.g. because a new map
+   * was loaded. The whole map has to be redrawn then.
+   */
+  bool getChangedTiles(uint64_t revision, std::vector<int>& tiles) const;
+
   /**
    * @brief Places an army at position x, y
    *
@@ -50,7 +154,7 @@ class GameState {
    * @param owner
    * @param unitCount
    */
-  void addArmy(ArmyType type, int x, int y, std::shared_ptr<Player> owner,
+  void addArmy(ArmyType type, int x, int y, PlayerIndex owner,
                int unitCount = 0);
 
   /**
@@ -90,14 +194,172 @@ class GameState {
    */
   void loadMapFromString(const std::string str, int num_cols);
 
+  /**
+   * @brief Loads a map read from a map file, sized by its header
+   *
+   * @param map
+   */
+  void loadMap(const MapFile& map);
+
+  /**
+   * @brief Loads a binary map, copying its layers as they are
+   *
+   * @param map
+   */
+  void loadMap(const MappedMap& map);
+
+  /**
+   * @brief Writes the terrain and ownership of the map to a binary map file
+   *
+   * @param filename
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void saveMap(const std::string& filename) const;
+
+  /**
+   * @brief Writes the complete state of the match to a snapshot: the map,
+   * all entities, the turn, the random streams and the state of every player
+   *
+   * Players are not created by a snapshot, they write and read their own
+   * state through Player::saveState and Player::readState.
+   *
+   * @param writer
+   */
+  void writeSnapshot(SnapshotWriter& writer) const;
+
+  /**
+   * @brief Restores a snapshot written by writeSnapshot
+   *
+   * The game must have the same players, added in the same order, as the game
+   * the snapshot was taken of. Everything else is replaced. If the snapshot
+   * is malformed the game and its players are left unchanged.
+   *
+   * @param reader
+   * @throws std::invalid_argument if the snapshot is malformed or of a game
+   * with other players
+   */
+  void readSnapshot(SnapshotReader& reader);
+
+  /**
+   * @brief Writes a snapshot of the match to a file
+   *
+   * @param filename
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void saveSnapshot(const std::string& filename) const;
+
+  /**
+   * @brief Restores a match from a snapshot file
+   *
+   * @param filename
+   * @throws std::runtime_error if the file cannot be read
+   * @throws std::invalid_argument if the file is not a snapshot of this game
+   */
+  void loadSnapshot(const std::string& filename);
+
+  /**
+   * @brief Starts recording every action taken in the match into a journal
+   *
+   * The journal begins with a snapshot of the game as it is now. Actions are
+   * recorded by moveArmy, colonize, addBuilding, placeSoldiers,
+   * incrementArmyUnit and nextTurn.
+   *
+   * @param journal nullptr to stop recording
+   */
+  void setJournal(std::shared_ptr<Journal> journal);
+
+  /**
+   * @brief Applies an action recorded in a journal
+   *
+   * NEXT_TURN advances the turn without letting the next player take it,
+   * whatever that player did is recorded as actions of its own. UNDO calls
+   * undo, every other action goes through execute.
+   *
+   * @param action
+   * @throws std::invalid_argument if the action does not fit the game, e.g.
+   * there is no army on its tile or nothing to undo
+   */
+  void applyAction(const Action& action);
+
+  /**
+   * @brief Carries out an action such that it can be undone
+   *
+   * Works like calling moveArmy, colonize, addBuilding, placeSoldiers or
+   * incrementArmyUnit directly, except that every change the action makes is
+   * recorded in the command log. ADD_BUILDING also charges the owner the cost
+   * of the building, like placing one does. The log is cleared when the turn
+   * ends, so only actions of the current turn can be undone.
+   *
+   * Search-based players can execute a move, evaluate the game and undo it
+   * again instead of copying the game.
+   *
+   * @param action any type but NEXT_TURN and UNDO
+   * @throws std::invalid_argument if the action does not fit the game: there
+   * is no army on its tile, the army cannot reach the tile it moves to, the
+   * building cannot be placed on its tile or the player has no townhall to
+   * recruit at
+   */
+  void execute(const Action& action);
+
+  /**
+   * @brief Takes back the latest executed action that was not undone yet
+   *
+   * The game is left as it was before the action, except that armies may be
+   * iterated in another order. Handles of armies the action erased are valid
+   * again, armies it created are gone for good: a redo creates new ones.
+   *
+   * @return false if there is nothing to undo
+   */
+  bool undo();
+
+  /**
+   * @brief Carries out the latest undone action again
+   *
+   * @return false if there is nothing to redo
+   */
+  bool redo();
+
+  bool canUndo() const;
+  bool canRedo() const;
+
   /**
    * @brief Get a Tile at position (X, Y)
    *
+   * The map is not stored as Tile objects, the Tile is assembled from the map
+   * layers on demand. Prefer getTileType and getTileOwner in hot code.
+   *
    * @param xPos
    * @param yPos
-   * @return Tile&
+   * @return Tile
    */
-  Tile& getTile(int xPos, int yPos);
+  Tile getTile(int xPos, int yPos) const;
+
+  /**
+   * @brief Get the type of the Tile at position (X, Y)
+   *
+   * @param xPos
+   * @param yPos
+   * @return TileType
+   */
+  TileType getTileType(int xPos, int yPos) const;
+
+  /**
+   * @brief Set the type of the Tile at position (X, Y)
+   *
+   * @param xPos
+   * @param yPos
+   * @param type
+   */
+  void setTileType(int xPos, int yPos, TileType type);
+
+  /**
+   * @brief Get the owner of the Tile at position (X, Y)
+   *
+   * @param xPos
+   * @param yPos
+   * @return PlayerIndex, NO_PLAYER if the tile is unclaimed
+   */
+  PlayerIndex getTileOwner(int xPos, int yPos) const;
 
   /**
    * @brief Get all claimed tiles by a player
@@ -107,6 +369,55 @@ class GameState {
    */
   std::vector<Tile> getClaimedTiles(const std::shared_ptr<Player> player);
 
+  /**
+   * @brief Get the tiles claimed by a player that have neither a building nor
+   * a townhall on them
+   *
+   * Only the tiles owned by the player are visited, not the whole map.
+   *
+   * @param player
+   * @return std::vector<std::pair<int, int>> coordinates of the free tiles
+   */
+  std::vector<std::pair<int, int>> getFreeClaimedTiles(
+      const std::shared_ptr<Player>& player);
+
+  /**
+   * @brief Get the number of tiles claimed by a player
+   *
+   * @param player
+   * @return int
+   */
+  int getClaimedTileCount(const std::shared_ptr<Player>& player) const;
+
+  /**
+   * @brief Get the resources a player's buildings produce every turn
+   *
+   * @param player
+   * @return Resources
+   */
+  Resources getIncome(const std::shared_ptr<Player>& player) const;
+
+  /**
+   * @brief Get the resources a player's buildings of one type produce every
+   * turn
+   *
+   * @param player
+   * @param type
+   * @return Resources
+   */
+  Resources getIncome(const std::shared_ptr<Player>& player,
+                      BuildingType type) const;
+
+  /**
+   * @brief Get the number of buildings of one type a player owns
+   *
+   * @param player
+   * @param type
+   * @return int
+   */
+  int getBuildingCount(const std::shared_ptr<Player>& player,
+                       BuildingType type) const;
+
   /**
    * @brief Finds a TownHall at location (X, Y) if it exists
    *
@@ -130,9 +441,9 @@ class GameState {
    *
    * @param xPos
    * @param yPos
-   * @return pointer to the player
+   * @return PlayerIndex, NO_PLAYER if there is no townhall
    */
-  std::shared_ptr<Player> getTownhallOwner(int x, int y);
+  PlayerIndex getTownhallOwner(int x, int y);
 
   /**
    * @brief Returns true if (X, Y) tile has a townhall on it and if the owner of
@@ -145,27 +456,66 @@ class GameState {
   bool tileHasTownhall(int xPos, int yPos);
 
   /**
-   * @brief Helper for getting all neighbours of a Tile at position (X, Y) in a
-   * certain radius
+   * @brief Calls visit(x, y) for every neighbour of a tile that is on the map,
+   * without copying tiles or allocating
    *
-   * @param xPos
-   * @param yPos
-   * @param radius
-   * @return Vector of std::vector<Tile>&
+   * @tparam C FOUR_CONNECTED or EIGHT_CONNECTED
+   * @tparam Radius
+   * @param x
+   * @param y
+   * @param visit
    */
-  std::vector<Tile> getNeighbourTiles(int xPos, int yPos, int radius);
+  template <Connectivity C, int Radius = 1, typename Visitor>
+  void forEachNeighbour(int x, int y, Visitor&& visit) const {
+    ::forEachNeighbour<C, Radius>(x, y, getNumCols(), num_rows_, visit);
+  }
 
   /**
-   * @brief Helper for getting all neighbours of a Tile at position (X, Y) in a
-   * certain radius without the diagonal (useful for army)
+   * @brief Get the width of the map
    *
-   * @param xPos
-   * @param yPos
-   * @param radius
-   * @return std::vector<Tile>
+   * @return int
    */
-  std::vector<Tile> getNeighbourGrassTilesNoDiagonal(int xPos, int yPos,
-                                                     int radius);
+  int getNumCols() const;
+
+  /**
+   * @brief Get the height of the map
+   *
+   * @return int
+   */
+  int getNumRows() const;
+
+  /**
+   * @brief Get the shortest paths toward a target for a movement class
+   *
+   * Fields are built on first use and cached until the terrain changes, so
+   * all armies heading to the same target share one field.
+   *
+   * @param targetX
+   * @param targetY
+   * @param movement
+   * @return const FlowField&, valid until the terrain changes
+   * @throws std::out_of_range if the target is not on the map
+   */
+  const FlowField& getFlowField(int targetX, int targetY,
+                                MovementClass movement);
+
+  /**
+   * @brief Check if a unit of a movement class could ever get from one tile
+   * to another, ignoring armies and owners in the way
+   *
+   * Answered from regions labeled when the map is loaded or edited, without
+   * searching a path.
+   *
+   * @param movement
+   * @param fromX
+   * @param fromY
+   * @param toX
+   * @param toY
+   * @return true
+   * @return false if either tile is off the map or cannot be entered
+   */
+  bool canReach(MovementClass movement, int fromX, int fromY, int toX,
+                int toY) const;
 
   /**
    * @brief Calculates soldier placement for a townhall at position (X, Y)
@@ -174,6 +524,7 @@ class GameState {
    * @param yPos
    * @return A pair of coordinates, (-1,-1) if Soldiers cannot be placed
    * anywhere
+   * @throws std::invalid_argument if the player has no townhall
    */
   void placeSoldiers(std::shared_ptr<Player> player, ArmyType armyType);
 
@@ -197,12 +548,24 @@ class GameState {
   /**
    * @brief Get the Visible XY coordinate pairs that a player can see
    *
-   * @return const std::vector<Tile>&
+   * @return std::vector<std::pair<int, int>>
    */
-  // TODO add a reference to a player such that the map is drawn for that player
-  // only (fog of war)
   std::vector<std::pair<int, int>> getVisibleXY(std::shared_ptr<Player> player);
 
+  /**
+   * @brief Checks if the tile at x, y is visible to a player (fog of war)
+   *
+   * A tile is visible if the player owns, or has an army, building or townhall
+   * on, the tile itself or one of its neighbours.
+   *
+   * @param player
+   * @param x
+   * @param y
+   * @return true
+   * @return false
+   */
+  bool isVisible(std::shared_ptr<Player> player, int x, int y);
+
   /**
    * @brief Get the Visible Tile objects that a player can see
    *
@@ -231,6 +594,42 @@ class GameState {
    */
   std::vector<Army> getVisibleArmies(std::shared_ptr<Player> player);
 
+  /**
+   * @brief Get a view over the coordinates of the tiles a player can see
+   *
+   * @param player
+   * @return VisibleTileView
+   */
+  VisibleTileView viewVisibleTiles(const std::shared_ptr<Player>& player);
+
+  /**
+   * @brief Get a view over the buildings a player can see, without copying
+   * them
+   *
+   * @param player
+   * @return VisibleView<Building>
+   */
+  VisibleView<Building> viewVisibleBuildings(
+      const std::shared_ptr<Player>& player);
+
+  /**
+   * @brief Get a view over the townhalls a player can see, without copying
+   * them
+   *
+   * @param player
+   * @return VisibleView<TownHall>
+   */
+  VisibleView<TownHall> viewVisibleTownhalls(
+      const std::shared_ptr<Player>& player);
+
+  /**
+   * @brief Get a view over the armies a player can see, without copying them
+   *
+   * @param player
+   * @return VisibleView<Army>
+   */
+  VisibleView<Army> viewVisibleArmies(const std::shared_ptr<Player>& player);
+
   /**
    * @brief Get the Army by location
    *
@@ -245,9 +644,17 @@ class GameState {
    *
    * @param x
    * @param y
-   * @return std::vector<Army>::iterator
+   * @return ArmyHandle, a stale handle if there is no army on the tile
    */
-  std::vector<Army>::iterator findArmyByLocation(int x, int y);
+  ArmyHandle findArmyByLocation(int x, int y) const;
+
+  /**
+   * @brief Resolves an ArmyHandle
+   *
+   * @param handle
+   * @return Army*, nullptr if the army no longer exists
+   */
+  Army* getArmy(ArmyHandle handle);
 
   /**
    * @brief Checks if the tile has an Army on it
@@ -259,11 +666,26 @@ class GameState {
    */
   bool tileHasArmy(int x, int y);
 
+  /**
+   * @brief Get the tiles an army can reach this turn and the paths there
+   *
+   * An army moves up to its speed in horizontal and vertical steps over
+   * terrain it can cross. It cannot step from a tile of an enemy to another
+   * tile of the same enemy, cannot enter a tile held by one of its own armies
+   * of another type, and ends its movement on any tile with an army, where it
+   * merges or fights. Does not check whether the army already moved.
+   *
+   * @param army
+   * @return MovementRange
+   */
+  MovementRange getMovementRange(const Army& army);
+
   /**
    * @brief Return the Army movement range
    *
    * @param army
-   * @return std::vector<std::pair<int, int>>
+   * @return std::vector<std::pair<int, int>>, empty if the army already moved
+   * this turn
    */
   std::vector<std::pair<int, int>> getArmyMovementRange(Army& army);
 
@@ -288,6 +710,15 @@ class GameState {
    */
   bool areCoordinatesValid(int x, int y) const;
 
+  /**
+   * @brief Converts the coordinates x, y into an index into the map storage
+   *
+   * @param x
+   * @param y
+   * @return int
+   */
+  int toIndex(int x, int y) const;
+
   /**
    * @brief Moves an army to position (R, C)
    *
@@ -308,10 +739,23 @@ class GameState {
    * @brief Get player armies
    *
    * @param player
-   * @return std::vector<std::reference_wrapper<Army>>
+   * @return std::vector<ArmyHandle>
+   */
+  std::vector<ArmyHandle> getPlayerArmies(std::shared_ptr<Player> player);
+
+  /**
+   * @brief Get all buildings on the map, whoever can see them
+   *
+   * @return const std::vector<Building>&
    */
-  std::vector<std::reference_wrapper<Army>> getPlayerArmies(
-      std::shared_ptr<Player> player);
+  const std::vector<Building>& getBuildings() const;
+
+  /**
+   * @brief Get all townhalls on the map, whoever can see them
+   *
+   * @return const std::vector<TownHall>&
+   */
+  const std::vector<TownHall>& getTownhalls() const;
 
   /**
    * @brief Finds building at location (xPos, yPos) if it exists
@@ -343,29 +787,241 @@ class GameState {
    */
   bool canPlaceBuilding(int x, int y, int playerID);
 
-  void handleGameover(std::shared_ptr<Player> player);
+  void handleGameover(PlayerIndex player);
 
   std::shared_ptr<Player> getWinner() const;
 
-  void destroyArmiesByPlayer(std::shared_ptr<Player> player);
+  void destroyArmiesByPlayer(PlayerIndex player);
 
-  void destroyBuildingsByPlayer(std::shared_ptr<Player> player);
+  void destroyBuildingsByPlayer(PlayerIndex player);
 
   void incrementArmyUnit(Army& army);
 
  private:
-  std::shared_ptr<sf::RenderWindow> window_;
-
   int activePlayerID_;
   int turn_;
   std::vector<std::shared_ptr<Player>> players_;
 
-  int num_rows_;
-  std::vector<Tile> map_;
+  // Seed of the match and one random stream per player, indexed by
+  // PlayerIndex
+  uint64_t seed_;
+  std::vector<Random> randoms_;
+
+  // The map is stored as one layer per tile attribute, indexed by toIndex.
+  // Owners are stored as PlayerIndex, NO_PLAYER means unclaimed.
+  int num_rows_ = 0;
+  std::vector<uint8_t> terrain_;
+  std::vector<PlayerIndex> owners_;
+
+  // Ownership index: for every player the tile indices it owns, in no
+  // particular order, and for every owned tile its position in that list.
+  // Kept in sync by setTileOwner.
+  std::vector<std::vector<int>> ownedTiles_;
+  std::vector<int> ownedTilePos_;
+
+  // Tiles changed since revision mapChangesBase_, one entry per revision.
+  // Changes that affect the whole map clear the list. See getMapRevision.
+  uint64_t mapRevision_ = 0;
+  uint64_t mapChangesBase_ = 0;
+  std::vector<int> mapChanges_;
+
+  /**
+   * @brief Records that the terrain, owner or visibility of a tile changed
+   *
+   * @param index
+   */
+  void markTileChanged(int index);
+
+  /**
+   * @brief Records a change that may affect every tile
+   *
+   */
+  void markMapChanged();
+
+  // Income ledger: per player the summed production of its buildings and the
+  // number of buildings of each type. Kept in sync whenever a building is
+  // added or erased, so nextTurn does not have to walk the buildings.
+  std::vector<Resources> income_;
+  std::vector<std::array<int, NUM_BUILDING_TYPES>> buildingCounts_;
+
+  /**
+   * @brief Adds the production of a building to its owner's income, or
+   * removes it for a negative sign
+   *
+   * @param building
+   * @param sign 1 or -1
+   */
+  void updateIncome(const Building& building, int sign);
+
+  /**
+   * @brief Rebuilds the income ledger from the buildings
+   *
+   */
+  void rebuildIncome();
+
+  /**
+   * @brief Rebuilds the ownership index from the owners_ layer
+   *
+   */
+  void rebuildOwnedTiles();
+
+  /**
+   * @brief Everything nextTurn does before handing the turn to the next
+   * player
+   *
+   */
+  void advanceTurn();
+
+  // Journal the mutations are recorded in, nullptr if not recording
+  std::shared_ptr<Journal> journal_;
+
+  // Actions of the current turn that can be undone
+  CommandLog commands_;
+  // Undo steps of the command being carried out, nullptr outside of execute
+  // and redo. Every mutation below adds the step that reverses it.
+  std::vector<std::function<void()>>* undoSteps_ = nullptr;
+
+  /**
+   * @brief Carries out an action with the mutations it stands for
+   *
+   * @param action
+   */
+  void perform(const Action& action);
+
+  /**
+   * @brief Runs undo steps last to first
+   *
+   * @param steps
+   */
+  void revert(const std::vector<std::function<void()>>& steps);
+
+  /**
+   * @brief Records how to restore the unit count and turn state of an army
+   * which is about to change
+   *
+   * @param army
+   */
+  void recordArmyState(const Army& army);
+
+  /**
+   * @brief Takes the cost of an action from a player's resources
+   *
+   * @param player
+   * @param cost
+   */
+  void chargePlayer(PlayerIndex player, const Resources& cost);
+
+  /**
+   * @brief Rebuilds everything derived from the map layers after a map load
+   *
+   */
+  void onMapLoaded();
 
   std::vector<TownHall> townhalls_;
   std::vector<Building> buildings_;
-  std::vector<Army> armies_;
+  SlotMap<Army> armies_;
+
+  // Occupancy index: for every tile, the position of the townhall or building
+  // standing on it in the vectors above, -1 if there is none, and the handle
+  // of the army standing on it
+  std::vector<int> townhallGrid_;
+  std::vector<int> buildingGrid_;
+  std::vector<ArmyHandle> armyGrid_;
+
+  /**
+   * @brief Rebuilds the occupancy index from scratch
+   *
+   */
+  void rebuildOccupancy();
+
+  /**
+   * @brief Erases an army and removes it from the occupancy index
+   *
+   * @param handle
+   */
+  void eraseArmy(ArmyHandle handle);
+
+  /**
+   * @brief Brings back an erased army under its old handle
+   *
+   * @param handle
+   * @param army the army as it was erased
+   */
+  void restoreArmy(ArmyHandle handle, const Army& army);
+
+  /**
+   * @brief Erases the building at position index in buildings_ and updates the
+   * occupancy index of the buildings shifted by the erase
+   *
+   * @param index
+   */
+  void eraseBuilding(int index);
+
+  /**
+   * @brief Inserts a building at position index in buildings_, the inverse of
+   * eraseBuilding
+   *
+   * @param index
+   * @param building
+   */
+  void insertBuilding(int index, const Building& building);
+
+  // Flow fields by target tile index and movement class. They only depend on
+  // the terrain and are dropped whenever it changes.
+  std::unordered_map<int, FlowField> flowFields_;
+
+  // Regions of passable terrain per movement class, relabeled with the
+  // terrain
+  ConnectedComponents components_;
+
+  // Visibility is maintained incrementally by the mutations below. It is only
+  // recomputed from scratch when the map or the player list changes.
+  FogOfWar fog_;
+  bool isFogDirty_ = true;
+
+  /**
+   * @brief Recomputes the visibility of all players from scratch
+   *
+   */
+  void updateFogOfWar();
+
+  /**
+   * @brief Registers a vision source of a player at x, y which sees the tile
+   * and its neighbours
+   *
+   * @param player
+   * @param x
+   * @param y
+   */
+  void addVisionSource(PlayerIndex player, int x, int y);
+
+  /**
+   * @brief Unregisters a vision source of a player at x, y
+   *
+   * @param player
+   * @param x
+   * @param y
+   */
+  void removeVisionSource(PlayerIndex player, int x, int y);
+
+  /**
+   * @brief Sets the owner of the tile at x, y and moves its vision to the new
+   * owner
+   *
+   * @param x
+   * @param y
+   * @param player
+   */
+  void setTileOwner(int x, int y, PlayerIndex player);
+
+  /**
+   * @brief Moves an army to x, y and updates the occupancy index and vision
+   *
+   * @param army
+   * @param x
+   * @param y
+   */
+  void setArmyLocation(Army& army, int x, int y);
 };
 
 #endif  // SRC_GAMESTATE_HPP_
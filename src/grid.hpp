@@ -0,0 +1,127 @@
+#ifndef SRC_GRID_HPP_
+#define SRC_GRID_HPP_
+
+#include <array>
+#include <cstdlib>
+
+// Neighbourhoods on the tile grid. Visiting neighbours goes through a table of
+// offsets built at compile time, so it needs no allocation and the loops are
+// unrolled for the common small radii.
+
+/**
+ * @brief Which tiles count as neighbours
+ *
+ * FOUR_CONNECTED: tiles within Manhattan distance radius (no diagonals at
+ * radius 1). EIGHT_CONNECTED: tiles within the square of side 2 * radius + 1.
+ */
+enum Connectivity { FOUR_CONNECTED, EIGHT_CONNECTED };
+
+struct GridOffset {
+  int dx;
+  int dy;
+};
+
+/**
+ * @brief Get the number of neighbours of a tile away from the map border
+ *
+ * @tparam C
+ * @tparam Radius
+ * @return int
+ */
+template <Connectivity C, int Radius>
+constexpr int neighbourCount() {
+  return C == FOUR_CONNECTED ? 2 * Radius * (Radius + 1)
+                             : (2 * Radius + 1) * (2 * Radius + 1) - 1;
+}
+
+/**
+ * @brief Builds the offsets of all neighbours of a tile
+ *
+ * Ordered by dx first and dy second, the order the map loops in
+ * GameState have always visited tiles in.
+ *
+ * @tparam C
+ * @tparam Radius
+ * @return std::array<GridOffset, neighbourCount<C, Radius>()>
+ */
+template <Connectivity C, int Radius>
+constexpr std::array<GridOffset, neighbourCount<C, Radius>()>
+makeNeighbourOffsets() {
+  std::array<GridOffset, neighbourCount<C, Radius>()> offsets{};
+  int count = 0;
+  for (int dx = -Radius; dx <= Radius; dx++) {
+    for (int dy = -Radius; dy <= Radius; dy++) {
+      if (dx == 0 && dy == 0) continue;
+      int manhattan = (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+      if (C == FOUR_CONNECTED && manhattan > Radius) continue;
+      offsets[count++] = GridOffset{dx, dy};
+    }
+  }
+  return offsets;
+}
+
+template <Connectivity C, int Radius>
+inline constexpr auto NEIGHBOUR_OFFSETS = makeNeighbourOffsets<C, Radius>();
+
+/**
+ * @brief Calls visit(x, y) for every neighbour of x, y that is on the map
+ *
+ * @tparam C
+ * @tparam Radius
+ * @param x
+ * @param y
+ * @param numCols
+ * @param numRows
+ * @param visit
+ */
+template <Connectivity C, int Radius = 1, typename Visitor>
+inline void forEachNeighbour(int x, int y, int numCols, int numRows,
+                             Visitor&& visit) {
+  for (const GridOffset& offset : NEIGHBOUR_OFFSETS<C, Radius>) {
+    int nx = x + offset.dx;
+    int ny = y + offset.dy;
+    if (nx >= 0 && ny >= 0 && nx < numCols && ny < numRows) visit(nx, ny);
+  }
+}
+
+/**
+ * @brief Calls visit(x, y) for every neighbour of x, y that is on the map, for
+ * a radius only known at run time
+ *
+ * Radius 1 and 2 use the compile-time tables, larger ones fall back to
+ * plain loops in the same order.
+ *
+ * @tparam C
+ * @param x
+ * @param y
+ * @param radius
+ * @param numCols
+ * @param numRows
+ * @param visit
+ */
+template <Connectivity C, typename Visitor>
+inline void forEachNeighbour(int x, int y, int radius, int numCols,
+                             int numRows, Visitor&& visit) {
+  switch (radius) {
+    case 1:
+      forEachNeighbour<C, 1>(x, y, numCols, numRows, visit);
+      return;
+    case 2:
+      forEachNeighbour<C, 2>(x, y, numCols, numRows, visit);
+      return;
+    default:
+      break;
+  }
+  for (int dx = -radius; dx <= radius; dx++) {
+    int reach = C == FOUR_CONNECTED ? radius - std::abs(dx) : radius;
+    for (int dy = -reach; dy <= reach; dy++) {
+      int nx = x + dx;
+      int ny = y + dy;
+      if ((dx != 0 || dy != 0) && nx >= 0 && ny >= 0 && nx < numCols &&
+          ny < numRows)
+        visit(nx, ny);
+    }
+  }
+}
+
+#endif  // SRC_GRID_HPP_
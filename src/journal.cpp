@@ -0,0 +1,169 @@
+#include "journal.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "snapshot.hpp"
+
+namespace {
+
+const uint8_t JOURNAL_MAGIC[4] = {'S', '8', 'J', 'N'};
+
+// Only the fields an action type uses are written
+void writeAction(SnapshotWriter& writer, const Action& action) {
+  writer.writeU8(action.type);
+  switch (action.type) {
+    case MOVE_ARMY:
+      writer.writeI32(action.x);
+      writer.writeI32(action.y);
+      writer.writeI32(action.toX);
+      writer.writeI32(action.toY);
+      break;
+    case COLONIZE:
+    case INCREMENT_ARMY_UNIT:
+      writer.writeI32(action.x);
+      writer.writeI32(action.y);
+      break;
+    case ADD_BUILDING:
+      writer.writeI32(action.x);
+      writer.writeI32(action.y);
+      writer.writeU8(action.player);
+      writer.writeU8(action.unitType);
+      writeResources(writer, action.cost);
+      writeResources(writer, action.gain);
+      break;
+    case PLACE_SOLDIERS:
+      writer.writeU8(action.player);
+      writer.writeU8(action.unitType);
+      break;
+    case NEXT_TURN:
+    case UNDO:
+      break;
+  }
+}
+
+Action readAction(SnapshotReader& reader) {
+  Action action;
+  uint8_t type = reader.readU8();
+  if (type >= NUM_ACTION_TYPES)
+    throw std::invalid_argument("Unknown action in journal");
+  action.type = static_cast<ActionType>(type);
+  switch (action.type) {
+    case MOVE_ARMY:
+      action.x = reader.readI32();
+      action.y = reader.readI32();
+      action.toX = reader.readI32();
+      action.toY = reader.readI32();
+      break;
+    case COLONIZE:
+    case INCREMENT_ARMY_UNIT:
+      action.x = reader.readI32();
+      action.y = reader.readI32();
+      break;
+    case ADD_BUILDING:
+      action.x = reader.readI32();
+      action.y = reader.readI32();
+      action.player = reader.readU8();
+      action.unitType = reader.readU8();
+      action.cost = readResources(reader);
+      action.gain = readResources(reader);
+      break;
+    case PLACE_SOLDIERS:
+      action.player = reader.readU8();
+      action.unitType = reader.readU8();
+      break;
+    case NEXT_TURN:
+    case UNDO:
+      break;
+  }
+  return action;
+}
+
+}  // namespace
+
+void Journal::begin(uint64_t seed, std::vector<JournalPlayer> players,
+                    std::vector<uint8_t> snapshot) {
+  seed_ = seed;
+  players_ = std::move(players);
+  snapshot_ = std::move(snapshot);
+  actions_.clear();
+}
+
+void Journal::record(const Action& action) { actions_.push_back(action); }
+
+uint64_t Journal::getSeed() const { return seed_; }
+
+const std::vector<JournalPlayer>& Journal::getPlayers() const {
+  return players_;
+}
+
+const std::vector<uint8_t>& Journal::getSnapshot() const { return snapshot_; }
+
+const std::vector<Action>& Journal::getActions() const { return actions_; }
+
+int Journal::getTurnCount() const {
+  return std::count_if(
+      actions_.begin(), actions_.end(),
+      [](const Action& action) { return action.type == NEXT_TURN; });
+}
+
+void Journal::save(const std::string& filename) const {
+  SnapshotWriter writer;
+  writer.writeBytes(JOURNAL_MAGIC, 4);
+  writer.writeU32(VERSION);
+  writer.writeU64(seed_);
+  writer.writeU32(players_.size());
+  for (const JournalPlayer& player : players_) {
+    writer.writeU8(player.isComputer);
+    writer.writeU8(player.color.r);
+    writer.writeU8(player.color.g);
+    writer.writeU8(player.color.b);
+    writer.writeU8(player.color.a);
+  }
+  writer.writeU32(snapshot_.size());
+  writer.writeBytes(snapshot_.data(), snapshot_.size());
+  // Actions run to the end of the file, so more can be appended
+  for (const Action& action : actions_) writeAction(writer, action);
+
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file for writing: " +
+                             filename);
+  file.write(reinterpret_cast<const char*>(writer.getData().data()),
+             writer.getData().size());
+  if (!file) throw std::runtime_error("Could not write the file: " + filename);
+}
+
+Journal Journal::load(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file: " + filename);
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+
+  SnapshotReader reader(data);
+  if (!std::equal(JOURNAL_MAGIC, JOURNAL_MAGIC + 4, reader.readBytes(4)))
+    throw std::invalid_argument("Not a journal");
+  if (reader.readU32() != VERSION)
+    throw std::invalid_argument("Unsupported journal version");
+
+  Journal journal;
+  journal.seed_ = reader.readU64();
+  for (uint32_t count = reader.readU32(); count > 0; count--) {
+    JournalPlayer player;
+    player.isComputer = reader.readU8();
+    player.color.r = reader.readU8();
+    player.color.g = reader.readU8();
+    player.color.b = reader.readU8();
+    player.color.a = reader.readU8();
+    journal.players_.push_back(player);
+  }
+  uint32_t snapshotSize = reader.readU32();
+  const uint8_t* snapshot = reader.readBytes(snapshotSize);
+  journal.snapshot_.assign(snapshot, snapshot + snapshotSize);
+  while (!reader.atEnd()) journal.actions_.push_back(readAction(reader));
+  return journal;
+}
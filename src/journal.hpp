@@ -0,0 +1,126 @@
+#ifndef SRC_JOURNAL_HPP_
+#define SRC_JOURNAL_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "player.hpp"
+
+enum ActionType {
+  MOVE_ARMY,
+  COLONIZE,
+  ADD_BUILDING,
+  PLACE_SOLDIERS,
+  INCREMENT_ARMY_UNIT,
+  NEXT_TURN,
+  UNDO
+};
+constexpr int NUM_ACTION_TYPES = 7;
+
+/**
+ * @brief One mutation of a match, with everything needed to apply it again.
+ *
+ * Armies are identified by the tile they stand on when the action is taken.
+ * Which fields are used depends on the type:
+ *
+ *   MOVE_ARMY            x, y to toX, toY
+ *   COLONIZE             x, y
+ *   ADD_BUILDING         x, y, player, unitType, cost, gain
+ *   PLACE_SOLDIERS       player, unitType
+ *   INCREMENT_ARMY_UNIT  x, y
+ *   NEXT_TURN            nothing
+ *   UNDO                 nothing
+ *
+ * UNDO takes back the latest action of the turn that was not taken back yet,
+ * see GameState::undo. A redo is recorded as the action it repeats.
+ */
+struct Action {
+  ActionType type = NEXT_TURN;
+  int x = 0;
+  int y = 0;
+  int toX = 0;
+  int toY = 0;
+  PlayerIndex player = NO_PLAYER;
+  // ArmyType or BuildingType
+  uint8_t unitType = 0;
+  Resources cost;
+  Resources gain;
+};
+
+/**
+ * @brief Describes a player of a journaled match, so a replay can set up the
+ * same players.
+ */
+struct JournalPlayer {
+  bool isComputer = false;
+  Color color;
+};
+
+/**
+ * @brief Append-only record of everything that happened in a match.
+ *
+ * A journal starts with the match seed, its players and a snapshot of the
+ * game at the moment recording started, see GameState::setJournal. After that
+ * it holds every action in the order it was taken, decisions of the AI
+ * included, so a replay does not have to run the AI again.
+ */
+class Journal {
+ public:
+  static constexpr uint32_t VERSION = 1;
+
+  /**
+   * @brief Starts the journal over from a snapshot of the game
+   *
+   * @param seed
+   * @param players
+   * @param snapshot written by GameState::writeSnapshot
+   */
+  void begin(uint64_t seed, std::vector<JournalPlayer> players,
+             std::vector<uint8_t> snapshot);
+
+  /**
+   * @brief Appends an action
+   *
+   * @param action
+   */
+  void record(const Action& action);
+
+  uint64_t getSeed() const;
+  const std::vector<JournalPlayer>& getPlayers() const;
+  const std::vector<uint8_t>& getSnapshot() const;
+  const std::vector<Action>& getActions() const;
+
+  /**
+   * @brief Get the number of turns the journal covers
+   *
+   * @return int
+   */
+  int getTurnCount() const;
+
+  /**
+   * @brief Writes the journal to a file
+   *
+   * @param filename
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void save(const std::string& filename) const;
+
+  /**
+   * @brief Reads a journal file
+   *
+   * @param filename
+   * @return Journal
+   * @throws std::runtime_error if the file cannot be read
+   * @throws std::invalid_argument if the file is not a valid journal
+   */
+  static Journal load(const std::string& filename);
+
+ private:
+  uint64_t seed_ = 0;
+  std::vector<JournalPlayer> players_;
+  std::vector<uint8_t> snapshot_;
+  std::vector<Action> actions_;
+};
+
+#endif  // SRC_JOURNAL_HPP_
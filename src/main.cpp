@@ -1,10 +1,16 @@
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
-#include <fstream>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "gamestate.hpp"
+#include "mapfile.hpp"
+#include "mappedmap.hpp"
 #include "player.hpp"
 #include "playerAI.hpp"
+#include "replay.hpp"
 #include "tile.hpp"
 #include "ui.hpp"
 #include "ui/mainmenu.hpp"
@@ -12,27 +18,98 @@
 #include "ui/victory_screen.hpp"
 #include "uimanager.hpp"
 
-// constants for map moved to uimanager.hpp
+// Plays a journal back in the window at turnRate turns per second, shown
+// from the first player's view
+int runReplay(const std::string& filename, double turnRate) {
+  auto gs = std::make_shared<GameState>();
+  std::unique_ptr<Replay> replay;
+  try {
+    auto journal = std::make_shared<const Journal>(Journal::load(filename));
+    replay = std::make_unique<Replay>(gs, journal);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  if (!gs->getPlayer(0)) {
+    std::cerr << "The journal has no players" << std::endl;
+    return 1;
+  }
+
+  auto window = std::make_shared<sf::RenderWindow>(sf::VideoMode(1280, 1024),
+                                                   "Strategy-8 Replay");
+  window->setFramerateLimit(144);
+  sf::Font f;
+  if (!f.loadFromFile("HackNerdFont-Regular.ttf")) {
+    std::cerr << "Error loading font!" << std::endl;
+  }
+  UI ui(gs->getPlayer(0), gs, f, window);
+
+  sf::Clock clock;
+  bool failed = false;
+  while (window->isOpen()) {
+    for (auto event = sf::Event(); window->pollEvent(event);) {
+      if (event.type == sf::Event::Closed) window->close();
+      if (event.type == sf::Event::MouseWheelScrolled)
+        ui.processMouseWheelScrolled(event);
+      // Undo and redo would change the game being replayed, camera keys only
+      if (event.type == sf::Event::KeyPressed && !event.key.control)
+        ui.processKeyPressed(event);
+    }
+
+    if (!failed && !replay->isFinished() &&
+        clock.getElapsedTime().asSeconds() >= 1 / turnRate) {
+      clock.restart();
+      try {
+        replay->stepTurn();
+      } catch (const std::exception& e) {
+        std::cerr << "Replay stopped: " << e.what() << std::endl;
+        failed = true;
+      }
+    }
+
+    window->clear();
+    ui.displayUI();
+    window->display();
+  }
+  return failed ? 1 : 0;
+}
 
-// TODO should later be moved to a utils.cpp folder or sth
-std::string readFileToString(const std::string& filename);
+// Usage: main [--record JOURNAL] [--edit MAP]
+//        main --replay JOURNAL [--turn-rate TURNS_PER_SECOND]
+int main(int argc, char* argv[]) {
+  std::string recordFile;
+  std::string editFile = "maps/grey.txt";
+  std::string replayFile;
+  double turnRate = 4;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string arg = argv[i];
+    if (arg == "--record") {
+      recordFile = argv[i + 1];
+    } else if (arg == "--edit") {
+      editFile = argv[i + 1];
+    } else if (arg == "--replay") {
+      replayFile = argv[i + 1];
+    } else if (arg == "--turn-rate") {
+      turnRate = std::max(0.01, std::atof(argv[i + 1]));
+    }
+  }
+  if (!replayFile.empty()) return runReplay(replayFile, turnRate);
 
-int main() {
   auto window = std::make_shared<sf::RenderWindow>(sf::VideoMode(1280, 1024),
                                                    "Strategy-8");
   window->setFramerateLimit(144);
 
-  std::shared_ptr<GameState> gs = std::make_shared<GameState>(window);
+  std::shared_ptr<GameState> gs = std::make_shared<GameState>();
   UIManager uiManager = UIManager();
   //!!!TEMP  modified player Colors: (just so you can see that the tile is
   //! highlighted)
   std::shared_ptr<Player> player1 =
-      std::make_shared<Player>(sf::Color(0, 128, 128), 1);
+      std::make_shared<Player>(Color(0, 128, 128), 1);
   // std::shared_ptr<PlayerAI> player1 =
-  // std::make_shared<PlayerAI>(sf::Color(0,128,128), 1, gs);
+  // std::make_shared<PlayerAI>(Color(0,128,128), 1, gs);
 
   std::shared_ptr<PlayerAI> player2 =
-      std::make_shared<PlayerAI>(sf::Color(0, 0, 128), 2, gs);
+      std::make_shared<PlayerAI>(Color(0, 0, 128), 2, gs);
 
   // player1->addSharedPtr(player1);
   player2->addSharedPtr(player2);
@@ -42,7 +119,6 @@ int main() {
 
   // create the map
   std::string filename = "maps/example1.txt";
-  std::string fileContent = readFileToString(filename);
 
   // for debugging purposes, map file has to be in /build/maps/map_file_name.txt
   // you can also edit the map file directly in the build directory and won't
@@ -50,7 +126,17 @@ int main() {
   std::filesystem::path fullPath = std::filesystem::absolute(filename);
   std::cout << "Accessing file: " << fullPath << std::endl;
 
-  gs->loadMapFromString(fileContent, NUM_OF_ROWS);
+  try {
+    if (MappedMap::isBinaryMap(filename)) {
+      gs->loadMap(MappedMap(filename));
+    } else {
+      gs->loadMap(MapFile::load(filename));
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  std::cout << "Match seed: " << gs->getSeed() << std::endl;
 
   // claim some test tiles
   gs->claimTile(4, 4, player1);
@@ -70,16 +156,16 @@ int main() {
   // gs->claimTile(8, 8, player2);
 
   // place some test Townhalls
-  TownHall townhall1(1, 1, player1, 4, 4);
-  TownHall townhall2(2, 1, player2, 18, 15);
+  TownHall townhall1(1, 1, player1->getIndex(), 4, 4);
+  TownHall townhall2(2, 1, player2->getIndex(), 18, 15);
   gs->addTownhall(townhall1);
   gs->addTownhall(townhall2);
 
   // place some test armies
-  gs->addArmy(ARTILLERY, 1, 1, player1, 4);
-  gs->addArmy(CAVALRY, 1, 2, player2, 100);
+  gs->addArmy(ARTILLERY, 1, 1, player1->getIndex(), 4);
+  gs->addArmy(CAVALRY, 1, 2, player2->getIndex(), 100);
   // gs->addArmy(CAVALRY, 1, 1, player1, 300);
-  gs->addArmy(CAVALRY, 17, 14, player1, 300);
+  gs->addArmy(CAVALRY, 17, 14, player1->getIndex(), 300);
   // gs->addArmy(6, 6, player1, 3);
   // gs->addArmy(7, 6, player1, 2);
   // gs->addArmy(5, 7, player1, 12);
@@ -116,7 +202,7 @@ int main() {
 
   MainMenu mainmenu = MainMenu(uiManager, f, window);
 
-  MapEditor mapeditor = MapEditor(uiManager, f, window);
+  MapEditor mapeditor = MapEditor(uiManager, f, window, editFile);
 
   UI player1ui = UI(player1, gs, f, window);
   UI player2ui = UI(player2, gs, f, window);
@@ -125,6 +211,13 @@ int main() {
 
   gs->setActivePlayerID(player2->getID());
 
+  // Records the match from here on, e.g. to reproduce a bug with --replay
+  std::shared_ptr<Journal> journal;
+  if (!recordFile.empty()) {
+    journal = std::make_shared<Journal>();
+    gs->setJournal(journal);
+  }
+
   while (window->isOpen()) {
     int currentPlayerID = gs->getActivePlayerID();
     UIState uiState = uiManager.getState();
@@ -150,6 +243,24 @@ int main() {
           mapeditor.processMouseButtonPressed(event);
         }
       }
+      if (event.type == sf::Event::KeyPressed && uiState == GAME) {
+        if (player1->getID() == currentPlayerID)
+          player1ui.processKeyPressed(event);
+        else if (player2->getID() == currentPlayerID)
+          player2ui.processKeyPressed(event);
+      }
+      if (event.type == sf::Event::MouseWheelScrolled && uiState == GAME) {
+        if (player1->getID() == currentPlayerID)
+          player1ui.processMouseWheelScrolled(event);
+        else if (player2->getID() == currentPlayerID)
+          player2ui.processMouseWheelScrolled(event);
+      }
+      if (uiState == MAPEDITOR) {
+        if (event.type == sf::Event::KeyPressed)
+          mapeditor.processKeyPressed(event);
+        if (event.type == sf::Event::MouseWheelScrolled)
+          mapeditor.processMouseWheelScrolled(event);
+      }
     }
 
     if (uiState == GAME && gs->getWinner()) uiManager.setState(VICTORY);
@@ -174,22 +285,14 @@ int main() {
 
     window->display();
   }
-}
-
-std::string readFileToString(const std::string& filename) {
-  std::ifstream file(filename);
-  std::string line;
-  std::string content;
 
-  if (!file.is_open()) {
-    std::cerr << "Could not open the file: " << filename << std::endl;
-    return "";
-  }
-  // Read each line from the file and append it to the content string
-  while (std::getline(file, line)) {
-    content += line;
+  if (journal) {
+    try {
+      journal->save(recordFile);
+      std::cout << "Match recorded to " << recordFile << std::endl;
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
   }
-
-  file.close();
-  return content;
-}
\ No newline at end of file
+}
@@ -0,0 +1,108 @@
+#include "mapfile.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "tile.hpp"
+
+namespace {
+
+const char* const HEADER = "MAP";
+
+bool isTile(char c) { return c == 'G' || c == 'W' || c == 'R' || c == 'N'; }
+
+}  // namespace
+
+MapFile::MapFile(int numCols, int numRows, std::string tiles)
+    : numCols_(numCols), numRows_(numRows), tiles_(std::move(tiles)) {
+  if (numCols < 0 || numRows < 0 ||
+      tiles_.size() != static_cast<size_t>(numCols) * numRows)
+    throw std::invalid_argument("Map size does not match its tiles");
+  for (char c : tiles_) {
+    if (!isTile(c)) throw std::invalid_argument("Unknown tile in map");
+  }
+}
+
+MapFile MapFile::parse(const std::string& text) {
+  std::vector<std::string> lines;
+  std::istringstream in(text);
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (!line.empty()) lines.push_back(line);
+  }
+
+  std::string tiles;
+  if (!lines.empty() && lines[0].rfind(HEADER, 0) == 0) {
+    std::istringstream header(lines[0].substr(std::string(HEADER).size()));
+    int version = 0;
+    int numCols = -1;
+    int numRows = -1;
+    if (!(header >> version >> numCols >> numRows))
+      throw std::invalid_argument("Malformed map header");
+    if (version != VERSION)
+      throw std::invalid_argument("Unsupported map version");
+    for (size_t i = 1; i < lines.size(); i++) {
+      if (lines[i].size() != static_cast<size_t>(numRows))
+        throw std::invalid_argument("Map column does not match its header");
+      tiles += lines[i];
+    }
+    return MapFile(numCols, numRows, std::move(tiles));
+  }
+
+  // Legacy map without a header
+  int numRows = lines.empty() ? 0 : lines[0].size();
+  for (const std::string& column : lines) {
+    if (column.size() != static_cast<size_t>(numRows))
+      throw std::invalid_argument("Map columns differ in length");
+    tiles += column;
+  }
+  return MapFile(lines.size(), numRows, std::move(tiles));
+}
+
+MapFile MapFile::load(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file: " + filename);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return parse(content.str());
+}
+
+std::string MapFile::toString() const {
+  std::ostringstream out;
+  out << HEADER << ' ' << VERSION << ' ' << numCols_ << ' ' << numRows_
+      << '\n';
+  for (int x = 0; x < numCols_; x++) {
+    out.write(tiles_.data() + x * numRows_, numRows_);
+    out << '\n';
+  }
+  return out.str();
+}
+
+void MapFile::save(const std::string& filename) const {
+  std::ofstream file(filename);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file for writing: " +
+                             filename);
+  file << toString();
+  if (!file) throw std::runtime_error("Could not write the file: " + filename);
+}
+
+int MapFile::getNumCols() const { return numCols_; }
+
+int MapFile::getNumRows() const { return numRows_; }
+
+const std::string& MapFile::getTiles() const { return tiles_; }
+
+std::vector<uint8_t> MapFile::toTerrain() const {
+  std::vector<uint8_t> terrain(tiles_.size(), GRASS);
+  for (size_t i = 0; i < tiles_.size(); i++) {
+    if (tiles_[i] == 'W') terrain[i] = WATER;
+    if (tiles_[i] == 'R') terrain[i] = ROCK;
+  }
+  return terrain;
+}
@@ -0,0 +1,103 @@
+#ifndef SRC_MAPFILE_HPP_
+#define SRC_MAPFILE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A map as it is stored on disk: its size and the type of every tile.
+ *
+ * Map files are text. The first line is a header with the format version and
+ * the size of the map, then every following line holds one column of tiles:
+ *
+ *   MAP 1 <columns> <rows>
+ *   GGWGG...
+ *
+ * with 'G' for grass, 'W' for water, 'R' for rock and 'N' for an unset tile.
+ * Files without a header are read the way they used to be: one column per
+ * line, with the number of rows taken from the length of the lines.
+ *
+ * Tiles are stored column-major like GameState stores them, so the tiles
+ * string can be handed to GameState::loadMapFromString as is.
+ */
+class MapFile {
+ public:
+  static constexpr int VERSION = 1;
+
+  /**
+   * @brief Construct an empty map
+   *
+   */
+  MapFile() = default;
+
+  /**
+   * @brief Construct a map from its tiles
+   *
+   * @param numCols
+   * @param numRows
+   * @param tiles one character per tile, column-major
+   * @throws std::invalid_argument if the size does not match the tiles or a
+   * tile character is unknown
+   */
+  MapFile(int numCols, int numRows, std::string tiles);
+
+  /**
+   * @brief Reads a map from the contents of a map file
+   *
+   * @param text
+   * @return MapFile
+   * @throws std::invalid_argument if the text is not a valid map
+   */
+  static MapFile parse(const std::string& text);
+
+  /**
+   * @brief Reads a map file
+   *
+   * @param filename
+   * @return MapFile
+   * @throws std::runtime_error if the file cannot be opened
+   * @throws std::invalid_argument if the file is not a valid map
+   */
+  static MapFile load(const std::string& filename);
+
+  /**
+   * @brief Encodes the map with a header, the way save writes it
+   *
+   * @return std::string
+   */
+  std::string toString() const;
+
+  /**
+   * @brief Writes the map to a file
+   *
+   * @param filename
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void save(const std::string& filename) const;
+
+  int getNumCols() const;
+  int getNumRows() const;
+
+  /**
+   * @brief Get the tiles of the map
+   *
+   * @return const std::string& one character per tile, column-major
+   */
+  const std::string& getTiles() const;
+
+  /**
+   * @brief Get the terrain layer the way GameState loads it, unset tiles
+   * become grass
+   *
+   * @return std::vector<uint8_t> TileType of every tile, column-major
+   */
+  std::vector<uint8_t> toTerrain() const;
+
+ private:
+  int numCols_ = 0;
+  int numRows_ = 0;
+  std::string tiles_;
+};
+
+#endif  // SRC_MAPFILE_HPP_
@@ -0,0 +1,137 @@
+#include "mappedmap.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "tile.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIC[4] = {'S', '8', 'M', 'B'};
+constexpr size_t HEADER_SIZE = 20;
+
+uint32_t readU32(const uint8_t* bytes) {
+  return bytes[0] | bytes[1] << 8 | bytes[2] << 16 |
+         static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+void writeU32(std::ofstream& file, uint32_t value) {
+  char bytes[4] = {static_cast<char>(value), static_cast<char>(value >> 8),
+                   static_cast<char>(value >> 16),
+                   static_cast<char>(value >> 24)};
+  file.write(bytes, 4);
+}
+
+}  // namespace
+
+MappedMap::MappedMap(const std::string& filename) {
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw std::runtime_error("Could not open the file: " + filename);
+  struct stat info;
+  if (fstat(fd, &info) == -1) {
+    close(fd);
+    throw std::runtime_error("Could not read the file: " + filename);
+  }
+  size_ = info.st_size;
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+      throw std::runtime_error("Could not map the file: " + filename);
+    data_ = static_cast<const uint8_t*>(data);
+  } else {
+    close(fd);
+  }
+#else
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file: " + filename);
+  buffer_.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  // The destructor does not run for a constructor that throws
+  auto fail = [this](const char* reason) {
+#ifndef _WIN32
+    if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    throw std::invalid_argument(reason);
+  };
+
+  if (size_ < HEADER_SIZE || !std::equal(MAGIC, MAGIC + 4, data_))
+    fail("Not a binary map");
+  if (readU32(data_ + 4) != BINARY_VERSION)
+    fail("Unsupported binary map version");
+  uint32_t numCols = readU32(data_ + 8);
+  uint32_t numRows = readU32(data_ + 12);
+  hasOwners_ = readU32(data_ + 16) & LAYER_OWNERS;
+
+  uint64_t tiles = static_cast<uint64_t>(numCols) * numRows;
+  if (numCols > INT32_MAX || numRows > INT32_MAX || tiles > INT32_MAX ||
+      size_ != HEADER_SIZE + tiles * (hasOwners_ ? 2 : 1))
+    fail("Binary map size does not match its header");
+  numCols_ = numCols;
+  numRows_ = numRows;
+
+  const uint8_t* terrain = getTerrain();
+  for (uint64_t i = 0; i < tiles; i++) {
+    if (terrain[i] > PLACEHOLDER) fail("Unknown tile in binary map");
+  }
+}
+
+MappedMap::~MappedMap() {
+#ifndef _WIN32
+  if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+}
+
+bool MappedMap::isBinaryMap(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[4] = {};
+  return file.read(magic, 4) && std::equal(MAGIC, MAGIC + 4, magic);
+}
+
+void MappedMap::save(const std::string& filename, int numCols, int numRows,
+                     const std::vector<uint8_t>& terrain,
+                     const std::vector<uint8_t>& owners) {
+  size_t tiles = static_cast<size_t>(numCols) * numRows;
+  if (numCols < 0 || numRows < 0 || terrain.size() != tiles ||
+      (!owners.empty() && owners.size() != tiles))
+    throw std::invalid_argument("Map size does not match its layers");
+
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file for writing: " +
+                             filename);
+  file.write(MAGIC, 4);
+  writeU32(file, BINARY_VERSION);
+  writeU32(file, numCols);
+  writeU32(file, numRows);
+  writeU32(file, owners.empty() ? 0 : LAYER_OWNERS);
+  file.write(reinterpret_cast<const char*>(terrain.data()), terrain.size());
+  file.write(reinterpret_cast<const char*>(owners.data()), owners.size());
+  if (!file) throw std::runtime_error("Could not write the file: " + filename);
+}
+
+int MappedMap::getNumCols() const { return numCols_; }
+
+int MappedMap::getNumRows() const { return numRows_; }
+
+const uint8_t* MappedMap::getTerrain() const { return data_ + HEADER_SIZE; }
+
+const uint8_t* MappedMap::getOwners() const {
+  return hasOwners_ ? getTerrain() + numCols_ * numRows_ : nullptr;
+}
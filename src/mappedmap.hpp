@@ -0,0 +1,98 @@
+#ifndef SRC_MAPPEDMAP_HPP_
+#define SRC_MAPPEDMAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A binary map file mapped into memory, read-only.
+ *
+ * Binary maps hold the map layers exactly as GameState stores them, so they
+ * load with a plain copy instead of parsing a character per tile. The file is
+ * a 20 byte header followed by the layers, one byte per tile, column-major:
+ *
+ *   "S8MB"              magic
+ *   uint32 version      BINARY_VERSION
+ *   uint32 numCols
+ *   uint32 numRows
+ *   uint32 layers       LAYER_OWNERS if an ownership layer follows the terrain
+ *   uint8  terrain[numCols * numRows]     TileType of every tile
+ *   uint8  owners[numCols * numRows]      PlayerIndex of every tile, optional
+ *
+ * Integers are little-endian. The file stays mapped for the lifetime of the
+ * object; on platforms without mmap it is read into memory instead.
+ */
+class MappedMap {
+ public:
+  static constexpr uint32_t BINARY_VERSION = 1;
+  static constexpr uint32_t LAYER_OWNERS = 1;
+
+  /**
+   * @brief Maps a binary map file
+   *
+   * @param filename
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   * @throws std::invalid_argument if the file is not a valid binary map
+   */
+  explicit MappedMap(const std::string& filename);
+  ~MappedMap();
+
+  MappedMap(const MappedMap&) = delete;
+  MappedMap& operator=(const MappedMap&) = delete;
+
+  /**
+   * @brief Check if a file starts like a binary map
+   *
+   * @param filename
+   * @return true if the file exists and starts with the binary map magic
+   */
+  static bool isBinaryMap(const std::string& filename);
+
+  /**
+   * @brief Writes a binary map file
+   *
+   * @param filename
+   * @param numCols
+   * @param numRows
+   * @param terrain TileType of every tile, column-major
+   * @param owners PlayerIndex of every tile, column-major, or empty to leave
+   * out the ownership layer
+   * @throws std::invalid_argument if a layer does not match the size
+   * @throws std::runtime_error if the file cannot be written
+   */
+  static void save(const std::string& filename, int numCols, int numRows,
+                   const std::vector<uint8_t>& terrain,
+                   const std::vector<uint8_t>& owners = {});
+
+  int getNumCols() const;
+  int getNumRows() const;
+
+  /**
+   * @brief Get the terrain layer
+   *
+   * @return const uint8_t* numCols * numRows TileType values
+   */
+  const uint8_t* getTerrain() const;
+
+  /**
+   * @brief Get the ownership layer
+   *
+   * @return const uint8_t* numCols * numRows PlayerIndex values, nullptr if
+   * the file has no ownership layer
+   */
+  const uint8_t* getOwners() const;
+
+ private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  // Holds the file where it cannot be mapped
+  std::vector<uint8_t> buffer_;
+
+  int numCols_ = 0;
+  int numRows_ = 0;
+  bool hasOwners_ = false;
+};
+
+#endif  // SRC_MAPPEDMAP_HPP_
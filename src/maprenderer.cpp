@@ -0,0 +1,52 @@
+#include "maprenderer.hpp"
+
+#include "uimanager.hpp"
+#include "utils.hpp"
+
+sf::Color getTileColor(const GameState& gameState, TileType type,
+                       PlayerIndex owner) {
+  if (owner != NO_PLAYER && gameState.getPlayer(owner))
+    return toSfColor(gameState.getPlayer(owner)->getColor());
+  return getTerrainColor(type);
+}
+
+MapRenderer::MapRenderer(std::shared_ptr<GameState> gameState,
+                         std::shared_ptr<Player> player)
+    : gameState_(gameState), player_(player) {}
+
+void MapRenderer::draw(sf::RenderTarget& target, sf::IntRect tiles) {
+  update();
+  layer_.draw(target, sf::Vector2f(LEFT_MAP_OFFSET, TOP_MAP_OFFSET), tiles);
+}
+
+void MapRenderer::update() {
+  if (isBuilt_ && revision_ == gameState_->getMapRevision()) return;
+
+  int numCols = gameState_->getNumCols();
+  int numRows = gameState_->getNumRows();
+  bool isSameMap = isBuilt_ && layer_.getNumCols() == numCols &&
+                   layer_.getNumRows() == numRows;
+  if (isSameMap && gameState_->getChangedTiles(revision_, changedTiles_)) {
+    for (int index : changedTiles_) {
+      int x = index / numRows;
+      int y = index % numRows;
+      layer_.setTile(x, y,
+                     gameState_->isVisible(player_, x, y)
+                         ? getTileColor(*gameState_,
+                                        gameState_->getTileType(x, y),
+                                        gameState_->getTileOwner(x, y))
+                         : sf::Color::Transparent);
+    }
+  } else {
+    if (!layer_.reset(numCols, numRows))
+      std::cerr << "The map is too large to be drawn" << std::endl;
+    for (const auto& [x, y] : gameState_->viewVisibleTiles(player_)) {
+      layer_.setTile(x, y,
+                     getTileColor(*gameState_, gameState_->getTileType(x, y),
+                                  gameState_->getTileOwner(x, y)));
+    }
+  }
+  // Iterating the visible tiles may have recomputed the fog of war
+  revision_ = gameState_->getMapRevision();
+  isBuilt_ = true;
+}
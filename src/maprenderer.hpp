@@ -0,0 +1,68 @@
+#ifndef SRC_MAPRENDERER_HPP_
+#define SRC_MAPRENDERER_HPP_
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gamestate.hpp"
+#include "player.hpp"
+#include "tile.hpp"
+#include "tilelayer.hpp"
+
+/**
+ * @brief Get the color a tile is filled with
+ *
+ * @param gameState
+ * @param type
+ * @param owner
+ * @return sf::Color the owner's color, or the terrain color if unclaimed
+ */
+sf::Color getTileColor(const GameState& gameState, TileType type,
+                       PlayerIndex owner);
+
+/**
+ * @brief Draws the tiles a player sees, terrain and ownership, as one
+ * TileLayer.
+ *
+ * The layer is only touched when GameState's map revision changed since the
+ * last frame, and then only for the tiles GameState reports as changed, so a
+ * frame costs two sprite draws no matter how large the map is. Hidden tiles
+ * stay transparent.
+ */
+class MapRenderer {
+ public:
+  /**
+   * @brief Construct a new MapRenderer object
+   *
+   * @param gameState
+   * @param player whose view of the map is drawn
+   */
+  MapRenderer(std::shared_ptr<GameState> gameState,
+              std::shared_ptr<Player> player);
+
+  /**
+   * @brief Draws the tiles of the map that are on screen, updating the tiles
+   * that changed first
+   *
+   * @param target
+   * @param tiles columns and rows to draw, see Camera::getVisibleTiles
+   */
+  void draw(sf::RenderTarget& target, sf::IntRect tiles);
+
+ private:
+  void update();
+
+  std::shared_ptr<GameState> gameState_;
+  std::shared_ptr<Player> player_;
+
+  TileLayer layer_;
+  bool isBuilt_ = false;
+  // GameState's map revision the layer shows
+  uint64_t revision_ = 0;
+  // Reused to fetch the changed tiles without allocating every frame
+  std::vector<int> changedTiles_;
+};
+
+#endif  // SRC_MAPRENDERER_HPP_
@@ -0,0 +1,52 @@
+#include "movementrange.hpp"
+
+#include <algorithm>
+
+bool MovementRange::contains(int x, int y) const {
+  if (x < 0 || y < 0 || y >= numRows_) return false;
+  return findNode(x * numRows_ + y) > 0;
+}
+
+int MovementRange::getCost(int x, int y) const {
+  if (x < 0 || y < 0 || y >= numRows_) return -1;
+  int node = findNode(x * numRows_ + y);
+  return node == -1 ? -1 : nodes_[node].cost;
+}
+
+std::vector<std::pair<int, int>> MovementRange::getPath(int x, int y) const {
+  std::vector<std::pair<int, int>> path;
+  if (x < 0 || y < 0 || y >= numRows_) return path;
+  for (int node = findNode(x * numRows_ + y); node > 0;
+       node = nodes_[node].parent) {
+    path.push_back(std::make_pair(nodes_[node].index / numRows_,
+                                  nodes_[node].index % numRows_));
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+std::vector<std::pair<int, int>> MovementRange::getTiles() const {
+  std::vector<int> indices;
+  for (size_t node = 1; node < nodes_.size(); node++) {
+    indices.push_back(nodes_[node].index);
+  }
+  std::sort(indices.begin(), indices.end());
+
+  std::vector<std::pair<int, int>> tiles;
+  for (int index : indices) {
+    tiles.push_back(std::make_pair(index / numRows_, index % numRows_));
+  }
+  return tiles;
+}
+
+int MovementRange::getOriginX() const { return originX_; }
+
+int MovementRange::getOriginY() const { return originY_; }
+
+int MovementRange::findNode(int index) const {
+  int numNodes = nodes_.size();
+  for (int node = 0; node < numNodes; node++) {
+    if (nodes_[node].index == index) return node;
+  }
+  return -1;
+}
@@ -0,0 +1,137 @@
+#ifndef SRC_MOVEMENTRANGE_HPP_
+#define SRC_MOVEMENTRANGE_HPP_
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "grid.hpp"
+
+/**
+ * @brief The tiles a unit can reach with a movement budget, and the cheapest
+ * path to each of them.
+ *
+ * Built with a Dijkstra search from the unit's tile that stops expanding once
+ * the budget is spent, so the work depends on the size of the range and not
+ * on the size of the map. The rules of which steps are allowed come from the
+ * caller, see GameState::getMovementRange for the ones armies follow.
+ *
+ * Tiles are addressed like GameState does, column-major with numRows tiles per
+ * column.
+ */
+class MovementRange {
+ public:
+  /**
+   * @brief Construct an empty range that reaches nothing
+   *
+   */
+  MovementRange() = default;
+
+  /**
+   * @brief Searches the tiles reachable from x0, y0
+   *
+   * @param x0
+   * @param y0
+   * @param budget total cost the unit can spend
+   * @param numCols
+   * @param numRows
+   * @param stepCost stepCost(fromX, fromY, toX, toY) returns the cost of the
+   * horizontal or vertical step, or -1 if it is not allowed
+   * @param stopsAt stopsAt(x, y) returns true if a unit entering the tile has
+   * to end its movement there
+   */
+  template <typename StepCost, typename StopsAt>
+  MovementRange(int x0, int y0, int budget, int numCols, int numRows,
+                StepCost&& stepCost, StopsAt&& stopsAt)
+      : numRows_(numRows), originX_(x0), originY_(y0) {
+    nodes_.push_back(Node{x0 * numRows + y0, 0, -1});
+
+    using Entry = std::pair<int, int>;  // cost, position in nodes_
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    open.push(Entry(0, 0));
+    while (!open.empty()) {
+      auto [cost, node] = open.top();
+      open.pop();
+      if (cost > nodes_[node].cost) continue;
+
+      int x = nodes_[node].index / numRows;
+      int y = nodes_[node].index % numRows;
+      if (node != 0 && stopsAt(x, y)) continue;
+
+      forEachNeighbour<FOUR_CONNECTED>(
+          x, y, numCols, numRows, [&](int nx, int ny) {
+            int step = stepCost(x, y, nx, ny);
+            if (step < 0 || cost + step > budget) return;
+            int next = findNode(nx * numRows + ny);
+            if (next == -1) {
+              next = nodes_.size();
+              nodes_.push_back(Node{nx * numRows + ny, cost + step, node});
+            } else if (cost + step < nodes_[next].cost) {
+              nodes_[next].cost = cost + step;
+              nodes_[next].parent = node;
+            } else {
+              return;
+            }
+            open.push(Entry(cost + step, next));
+          });
+    }
+  }
+
+  /**
+   * @brief Check if the unit can end its movement on a tile
+   *
+   * @param x
+   * @param y
+   * @return true if the tile is reachable and is not the starting tile
+   */
+  bool contains(int x, int y) const;
+
+  /**
+   * @brief Get the cost of reaching a tile
+   *
+   * @param x
+   * @param y
+   * @return int, -1 if the tile cannot be reached
+   */
+  int getCost(int x, int y) const;
+
+  /**
+   * @brief Get the cheapest path to a tile
+   *
+   * @param x
+   * @param y
+   * @return std::vector<std::pair<int, int>> every tile entered on the way,
+   * ending with x, y. Empty if the tile cannot be reached.
+   */
+  std::vector<std::pair<int, int>> getPath(int x, int y) const;
+
+  /**
+   * @brief Get all tiles the unit can move to
+   *
+   * @return std::vector<std::pair<int, int>> ordered by x, then y
+   */
+  std::vector<std::pair<int, int>> getTiles() const;
+
+  int getOriginX() const;
+  int getOriginY() const;
+
+ private:
+  struct Node {
+    int index;
+    int cost;
+    // position of the previous tile of the path in nodes_, -1 for the origin
+    int parent;
+  };
+
+  // Ranges only cover a handful of tiles, a linear search beats hashing
+  int findNode(int index) const;
+
+  int numRows_ = 1;
+  int originX_ = -1;
+  int originY_ = -1;
+  // nodes_[0] is the origin
+  std::vector<Node> nodes_;
+};
+
+#endif  // SRC_MOVEMENTRANGE_HPP_
@@ -1,8 +1,10 @@
 #include "player.hpp"
 
+#include "snapshot.hpp"
+
 std::atomic<int> Player::idCounter_{1};
 
-Player::Player(sf::Color color, int turnOrder, Resources resources)
+Player::Player(Color color, int turnOrder, Resources resources)
     : color_(color),
       turnOrder_(turnOrder),
       resources_(resources),
@@ -23,8 +25,42 @@ void Player::modifyResources(const Resources& delta) {
 
 int Player::getID() { return id_; }
 
-sf::Color Player::getColor() { return color_; };
+Color Player::getColor() { return color_; };
+
+PlayerIndex Player::getIndex() const { return index_; }
+
+void Player::setIndex(PlayerIndex index) { index_ = index; }
 
 bool Player::getIsAlive() const { return isAlive_; }
 
 void Player::setIsAlive(bool isAlive) { isAlive_ = isAlive; }
+
+void Player::saveState(SnapshotWriter& writer) const {
+  writeResources(writer, resources_);
+  writer.writeU8(isAlive_);
+}
+
+std::function<void()> Player::readState(SnapshotReader& reader) {
+  Resources resources = readResources(reader);
+  bool isAlive = reader.readU8();
+  return [this, resources, isAlive] {
+    resources_ = resources;
+    isAlive_ = isAlive;
+  };
+}
+
+void writeResources(SnapshotWriter& writer, const Resources& resources) {
+  writer.writeI32(resources.food);
+  writer.writeI32(resources.wood);
+  writer.writeI32(resources.gold);
+  writer.writeI32(resources.stone);
+}
+
+Resources readResources(SnapshotReader& reader) {
+  Resources resources;
+  resources.food = reader.readI32();
+  resources.wood = reader.readI32();
+  resources.gold = reader.readI32();
+  resources.stone = reader.readI32();
+  return resources;
+}
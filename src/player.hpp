@@ -1,9 +1,15 @@
 #ifndef SRC_PLAYER_HPP_
 #define SRC_PLAYER_HPP_
 
-#include <SFML/Graphics.hpp>
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "color.hpp"
+
+class SnapshotReader;
+class SnapshotWriter;
 
 struct Resources {
   int food = 100;
@@ -18,6 +24,29 @@ struct Resources {
       : food(food), wood(wood), gold(gold), stone(stone) {}
 };
 
+/**
+ * @brief Writes resources to a snapshot
+ *
+ * @param writer
+ * @param resources
+ */
+void writeResources(SnapshotWriter& writer, const Resources& resources);
+
+/**
+ * @brief Reads resources written by writeResources
+ *
+ * @param reader
+ * @return Resources
+ */
+Resources readResources(SnapshotReader& reader);
+
+// Dense index of a player within a match, assigned by GameState::addPlayer.
+// Entities store it instead of a pointer to their owner.
+using PlayerIndex = uint8_t;
+
+// PlayerIndex of anything that is not owned by a player
+constexpr PlayerIndex NO_PLAYER = UINT8_MAX;
+
 class Player {
  public:
   /**
@@ -27,7 +56,7 @@ class Player {
    * @param turnOrder
    * @param resources
    */
-  Player(sf::Color color, int turnOrder, Resources resources = Resources());
+  Player(Color color, int turnOrder, Resources resources = Resources());
 
   /**
    * @brief Destroy the Player object
@@ -59,9 +88,9 @@ class Player {
   /**
    * @brief Get the Player Color object
    *
-   * @return sf::Color
+   * @return Color
    */
-  sf::Color getColor();
+  Color getColor();
 
   /**
    * @brief Function for turn behavior.
@@ -69,6 +98,44 @@ class Player {
    */
   virtual void doTurn() {};
 
+  /**
+   * @brief Check if the computer takes the turns of this player
+   *
+   * @return true for AI players
+   */
+  virtual bool isComputer() const { return false; }
+
+  /**
+   * @brief Writes the state the player builds up during a match to a
+   * snapshot. Subclasses with state of their own extend it.
+   *
+   * @param writer
+   */
+  virtual void saveState(SnapshotWriter& writer) const;
+
+  /**
+   * @brief Reads the state written by saveState without restoring it yet
+   *
+   * @param reader
+   * @return std::function<void()> restores the state that was read
+   * @throws std::invalid_argument if the snapshot is malformed
+   */
+  virtual std::function<void()> readState(SnapshotReader& reader);
+
+  /**
+   * @brief Get the index of the player within its match
+   *
+   * @return PlayerIndex, NO_PLAYER if the player has not been added to a game
+   */
+  PlayerIndex getIndex() const;
+
+  /**
+   * @brief Set the index of the player within its match
+   *
+   * @param index
+   */
+  void setIndex(PlayerIndex index);
+
   bool getIsAlive() const;
 
   void setIsAlive(bool isAlive);
@@ -77,9 +144,10 @@ class Player {
   int id_;
   Resources resources_;
   int turnOrder_;
-  sf::Color color_;
+  Color color_;
   static std::atomic<int> idCounter_;
   bool isAlive_;
+  PlayerIndex index_ = NO_PLAYER;
 };
 
 #endif  // SRC_PLAYER_HPP_
\ No newline at end of file
@@ -1,9 +1,42 @@
 #include "playerAI.hpp"
 
+#include <stdexcept>
+
+#include "snapshot.hpp"
+
 void PlayerAI::addSharedPtr(std::shared_ptr<PlayerAI> refToSelf) {
   self = refToSelf;
 }
 
+void PlayerAI::setTurnDelay(std::chrono::milliseconds delay) {
+  turnDelay_ = delay;
+}
+
+void PlayerAI::saveState(SnapshotWriter& writer) const {
+  Player::saveState(writer);
+  writer.writeI32(currentActionStep_);
+  writer.writeU8(toPlace);
+  writer.writeI32(enemyTownhallPosition_.first);
+  writer.writeI32(enemyTownhallPosition_.second);
+}
+
+std::function<void()> PlayerAI::readState(SnapshotReader& reader) {
+  std::function<void()> restorePlayer = Player::readState(reader);
+  int actionStep = reader.readI32();
+  uint8_t building = reader.readU8();
+  if (building >= NUM_BUILDING_TYPES)
+    throw std::invalid_argument("Unknown building type in snapshot");
+  std::pair<int, int> enemyTownhall;
+  enemyTownhall.first = reader.readI32();
+  enemyTownhall.second = reader.readI32();
+  return [this, restorePlayer, actionStep, building, enemyTownhall] {
+    restorePlayer();
+    currentActionStep_ = actionStep;
+    toPlace = static_cast<BuildingType>(building);
+    enemyTownhallPosition_ = enemyTownhall;
+  };
+}
+
 void PlayerAI::takeTurnActions() {
   currentActionStep_++;
 
@@ -12,7 +45,7 @@ void PlayerAI::takeTurnActions() {
 
   if (currentActionStep_ > maxSteps_) {
     // delay actions to see their impact
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (turnDelay_.count() > 0) std::this_thread::sleep_for(turnDelay_);
     currentActionStep_ = 0;
     gameState_->nextTurn();
   }
@@ -28,70 +61,51 @@ void PlayerAI::doArmyActions() {
   spawnArmy();
   checkForEnemyTownhall();
 
-  auto armies = gameState_->getPlayerArmies(self);
+  // Armies get merged and destroyed while we act. Their handles notice that,
+  // so armies that were merged away or defeated in the meantime are skipped.
+  for (ArmyHandle handle : gameState_->getPlayerArmies(self)) {
+    if (gameState_->getArmy(handle) == nullptr) continue;
 
-  for (Army& a : armies) {
     // if can colonize, do that
-    gameState_->colonize(a);
+    gameState_->colonize(*gameState_->getArmy(handle));
+    // colonizing can end the game for another player and destroy its armies,
+    // which moves ours in memory
+    Army& a = *gameState_->getArmy(handle);
     // randomly move it if townhall not discovered
 
     int targetX = enemyTownhallPosition_.first;
     int targetY = enemyTownhallPosition_.second;
 
-    int startX = a.getLocationX();
-    int startY = a.getLocationY();
-
-    // BFS to find the shortest path to the enemy townhall
-    std::queue<std::pair<int, int>> q;
-    std::map<std::pair<int, int>, std::pair<int, int>> cameFrom;
-    q.push({startX, startY});
-    cameFrom[{startX, startY}] = {-1, -1};
-
-    bool found = false;
-
-    while (!q.empty() && !found) {
-      auto [x, y] = q.front();
-      q.pop();
-
-      for (const auto& neighbor :
-           gameState_->getNeighbourGrassTilesNoDiagonal(x, y, 1)) {
-        int nx = neighbor.getX();
-        int ny = neighbor.getY();
-
-        if (cameFrom.find({nx, ny}) == cameFrom.end() &&
-            gameState_->areCoordinatesValid(nx, ny)) {
-          cameFrom[{nx, ny}] = {x, y};
-          q.push({nx, ny});
-          if (nx == targetX && ny == targetY) {
-            found = true;
-            break;
-          }
-        }
-      }
+    // all armies of a movement class share one field toward the townhall.
+    // Armies that can never get there, e.g. from another island, skip it.
+    MovementClass movement = getMovementClass(a.getType());
+    const FlowField* field = nullptr;
+    std::pair<int, int> next = std::make_pair(-1, -1);
+    if (targetX != -1 &&
+        gameState_->canReach(movement, a.getLocationX(), a.getLocationY(),
+                             targetX, targetY)) {
+      field = &gameState_->getFlowField(targetX, targetY, movement);
+      next = field->getNextStep(a.getLocationX(), a.getLocationY());
     }
 
-    // trace the path to the townhall
-    if (found) {
-      std::pair<int, int> current = {targetX, targetY};
-      while (cameFrom[current] != std::make_pair(startX, startY)) {
-        current = cameFrom[current];
+    if (next.first != -1) {
+      // follow the field as far as the army can move this turn
+      MovementRange range = gameState_->getMovementRange(a);
+      std::pair<int, int> destination = std::make_pair(-1, -1);
+      for (int step = 0; step < a.getSpeed() && next.first != -1; step++) {
+        if (!range.contains(next.first, next.second)) break;
+        destination = next;
+        next = field->getNextStep(next.first, next.second);
       }
-
-      // std::cout<<"army is at " << startX << ", " << startY << " and should
-      // move to " << current.first << ", " << current.second << std::endl;
-
-      if (gameState_->isArmyWithinMovementRange(a, current.first,
-                                                current.second)) {
-        gameState_->moveArmy(a, current.first, current.second);
+      if (destination.first != -1) {
+        gameState_->moveArmy(a, destination.first, destination.second);
       }
     } else {
       // random movement if no path is found
       auto possibleMoves = gameState_->getArmyMovementRange(a);
       if (!possibleMoves.empty()) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, possibleMoves.size() - 1);
-        int randomIndex = dis(gen);
+        int randomIndex =
+            gameState_->getRandom(getIndex()).nextInt(possibleMoves.size());
 
         gameState_->moveArmy(a, possibleMoves[randomIndex].first,
                              possibleMoves[randomIndex].second);
@@ -100,24 +114,47 @@ void PlayerAI::doArmyActions() {
   }
 }
 
-void PlayerAI::spawnArmy() { gameState_->placeSoldiers(self, INFANTRY); }
+void PlayerAI::spawnArmy() {
+  // Players that lost their townhall have nowhere to recruit
+  if (!getIsAlive()) return;
+  gameState_->placeSoldiers(self, chooseArmyType());
+}
+
+ArmyType PlayerAI::chooseArmyType() {
+  int targetX = enemyTownhallPosition_.first;
+  int targetY = enemyTownhallPosition_.second;
+  if (targetX == -1) return INFANTRY;
+
+  for (const TownHall& townhall : gameState_->viewVisibleTownhalls(self)) {
+    if (townhall.getOwner() != getIndex()) continue;
+
+    // armies are placed around the townhall, so check from those tiles
+    bool marinesCanReach = false;
+    for (const GridOffset& offset : NEIGHBOUR_OFFSETS<EIGHT_CONNECTED, 1>) {
+      int x = townhall.getX() + offset.dx;
+      int y = townhall.getY() + offset.dy;
+      if (gameState_->canReach(LAND, x, y, targetX, targetY)) return INFANTRY;
+      if (gameState_->canReach(AMPHIBIOUS, x, y, targetX, targetY))
+        marinesCanReach = true;
+    }
+    return marinesCanReach ? MARINE : INFANTRY;
+  }
+  return INFANTRY;
+}
 
 void PlayerAI::checkForEnemyTownhall() {
   if (enemyTownhallPosition_.first == -1) {
-    auto townhalls = gameState_->getVisibleTownhalls(self);
-    // remove own townhall
-    // std::cout << "Number of townhalls in sight:" << townhalls.size() <<
-    // std::endl;
-    townhalls.erase(std::remove_if(townhalls.begin(), townhalls.end(),
-                                   [this](const TownHall t) {
-                                     return t.getOwner() == self;
-                                   }),
-                    townhalls.end());
-    if (townhalls.size() == 1) {
-      std::cout << "Townhall visible to AI!" << std::endl;
+    int enemyTownhallCount = 0;
+    std::pair<int, int> enemyTownhallPosition;
+    for (const TownHall& townhall : gameState_->viewVisibleTownhalls(self)) {
+      // skip own townhall
+      if (townhall.getOwner() == getIndex()) continue;
+      enemyTownhallCount++;
+      enemyTownhallPosition = townhall.getXY();
+    }
+    if (enemyTownhallCount == 1) {
       // townhall found
-      auto th = townhalls[0];
-      enemyTownhallPosition_ = th.getXY();
+      enemyTownhallPosition_ = enemyTownhallPosition;
     }
   }
 }
@@ -133,36 +170,32 @@ void PlayerAI::doBuildActions() {
   bp.setType(toPlace);
 
   if (canAffordBuilding(toPlace)) {
-    auto claimedTiles = gameState_->getClaimedTiles(self);
-    bool placed = false;
-
-    for (auto tile : claimedTiles) {
-      if (!placed && !gameState_->tileHasBuilding(tile.getX(), tile.getY()) &&
-          !gameState_->tileHasTownhall(tile.getX(), tile.getY())) {
-        gameState_->addBuilding(Building(bp.getType(), bp.getResourceCost(),
-                                         bp.getResourceGain(), self,
-                                         tile.getX(), tile.getY()));
-        Resources cost = bp.getResourceCost();
-        Resources negatedCost(-cost.food, -cost.wood, -cost.gold, -cost.stone);
-        modifyResources(negatedCost);
-
-        // if (toPlace == WOOD_CUTTER) {
-        //     std::cout << "AI placed a Wood Cutter on " << tile.getX() << ", "
-        //     << tile.getY() << std::endl;
-        // } else if (toPlace == FARM) {
-        //     std::cout << "AI placed a Farm on " << tile.getX() << ", " <<
-        //     tile.getY()  << std::endl;
-        // } else if (toPlace == MINE) {
-        //     std::cout << "AI placed a Mine on " << tile.getX() << ", " <<
-        //     tile.getY()  << std::endl;
-        // } else if (toPlace == MARKET) {
-        //     std::cout << "AI placed a Market on " << tile.getX() << ", " <<
-        //     tile.getY()  << std::endl;
-        // }
-
-        setNextBuilding();
-        placed = true;
-      }
+    std::vector<std::pair<int, int>> freeTiles =
+        gameState_->getFreeClaimedTiles(self);
+
+    if (!freeTiles.empty()) {
+      auto [x, y] = freeTiles.front();
+      gameState_->addBuilding(Building(bp.getType(), bp.getResourceCost(),
+                                       bp.getResourceGain(), getIndex(), x, y));
+      Resources cost = bp.getResourceCost();
+      Resources negatedCost(-cost.food, -cost.wood, -cost.gold, -cost.stone);
+      modifyResources(negatedCost);
+
+      // if (toPlace == WOOD_CUTTER) {
+      //     std::cout << "AI placed a Wood Cutter on " << x << ", " << y
+      //     << std::endl;
+      // } else if (toPlace == FARM) {
+      //     std::cout << "AI placed a Farm on " << x << ", " << y
+      //     << std::endl;
+      // } else if (toPlace == MINE) {
+      //     std::cout << "AI placed a Mine on " << x << ", " << y
+      //     << std::endl;
+      // } else if (toPlace == MARKET) {
+      //     std::cout << "AI placed a Market on " << x << ", " << y
+      //     << std::endl;
+      // }
+
+      setNextBuilding();
     }
   }
 }
@@ -2,8 +2,6 @@
 #define SRC_PLAYERAI_HPP_
 
 #include <chrono>
-#include <queue>
-#include <random>
 #include <thread>
 #include <vector>
 
@@ -21,7 +19,7 @@ class PlayerAI : public Player {
    * @param difficulty
    * @param resources
    */
-  PlayerAI(sf::Color color, int turnOrder, std::shared_ptr<GameState> gameState,
+  PlayerAI(Color color, int turnOrder, std::shared_ptr<GameState> gameState,
            Resources resources = Resources(), int difficulty = 0)
       : Player(color, turnOrder, resources),
         gameState_(std::move(gameState)),
@@ -33,6 +31,8 @@ class PlayerAI : public Player {
    */
   void doTurn() override { takeTurnActions(); };
 
+  bool isComputer() const override { return true; }
+
   /**
    * @brief A function to add the AI's own pointer to itself
    *
@@ -40,6 +40,32 @@ class PlayerAI : public Player {
    */
   void addSharedPtr(std::shared_ptr<PlayerAI> refToSelf);
 
+  /**
+   * @brief Set how long the AI waits before ending its turn
+   *
+   * The delay lets a human watch the AI play. Simulations without a window
+   * should set it to zero.
+   *
+   * @param delay
+   */
+  void setTurnDelay(std::chrono::milliseconds delay);
+
+  /**
+   * @brief Writes the player's state and what the AI has learned about the
+   * match so far
+   *
+   * @param writer
+   */
+  void saveState(SnapshotWriter& writer) const override;
+
+  /**
+   * @brief Reads the state written by saveState without restoring it yet
+   *
+   * @param reader
+   * @return std::function<void()> restores the state that was read
+   */
+  std::function<void()> readState(SnapshotReader& reader) override;
+
  private:
   /**
    * @brief Takes all turn actions in order
@@ -59,6 +85,16 @@ class PlayerAI : public Player {
    */
   void spawnArmy();
 
+  /**
+   * @brief Picks the type of army to spawn
+   *
+   * Infantry, unless the enemy townhall is known and only marines can get
+   * there from our own townhall, e.g. because it is on another island.
+   *
+   * @return ArmyType
+   */
+  ArmyType chooseArmyType();
+
   /**
    * @brief Stores position of enemy townhall if it is in sight
    *
@@ -92,6 +128,7 @@ class PlayerAI : public Player {
   int difficulty_;
   int currentActionStep_ = 0;
   const int maxSteps_ = 1;
+  std::chrono::milliseconds turnDelay_ = std::chrono::milliseconds(10);
   // init to market such that woodcutter comes next
   BuildingType toPlace = WOOD_CUTTER;
   // as soon as enemy townhall is spotted, the coords will save it to here. -1
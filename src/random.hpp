@@ -0,0 +1,122 @@
+#ifndef SRC_RANDOM_HPP_
+#define SRC_RANDOM_HPP_
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Small, fast and seedable random number generator (PCG32).
+ *
+ * Two generators built from the same seed and stream produce the same
+ * sequence on every platform, which makes games reproducible. Generators with
+ * the same seed but different streams produce independent sequences, so every
+ * player of a match can draw from its own stream without the draws of one
+ * player changing those of another.
+ *
+ * Satisfies UniformRandomBitGenerator, so it also works with the <random>
+ * distributions, but those are not guaranteed to give the same results with
+ * every standard library. Use nextInt for decisions that have to replay.
+ */
+class Random {
+ public:
+  using result_type = uint32_t;
+
+  /**
+   * @brief Construct a new Random object
+   *
+   * @param seed
+   * @param stream selects one of 2^63 independent sequences
+   */
+  explicit Random(uint64_t seed = 0, uint64_t stream = 0) {
+    this->seed(seed, stream);
+  }
+
+  /**
+   * @brief Restart the generator at the beginning of a sequence
+   *
+   * @param seed
+   * @param stream
+   */
+  void seed(uint64_t seed, uint64_t stream = 0) {
+    state_ = 0;
+    increment_ = (stream << 1u) | 1u;
+    next();
+    state_ += seed;
+    next();
+  }
+
+  /**
+   * @brief Get the next 32 random bits
+   *
+   * @return uint32_t
+   */
+  uint32_t next() {
+    uint64_t old = state_;
+    state_ = old * MULTIPLIER + increment_;
+    uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = static_cast<uint32_t>(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+  }
+
+  /**
+   * @brief Get a uniformly distributed integer in [0, bound)
+   *
+   * @param bound must be positive
+   * @return int
+   */
+  int nextInt(int bound) {
+    // Lemire's multiply and shift, rejecting the few values that would make
+    // the low results more likely than the high ones
+    uint32_t range = static_cast<uint32_t>(bound);
+    uint64_t product = static_cast<uint64_t>(next()) * range;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < range) {
+      uint32_t threshold = -range % range;
+      while (low < threshold) {
+        product = static_cast<uint64_t>(next()) * range;
+        low = static_cast<uint32_t>(product);
+      }
+    }
+    return static_cast<int>(product >> 32);
+  }
+
+  /**
+   * @brief Get the position of the generator within its sequence, e.g. to
+   * save it
+   *
+   * @return uint64_t
+   */
+  uint64_t getState() const { return state_; }
+
+  /**
+   * @brief Get the sequence the generator walks, derived from its stream
+   *
+   * @return uint64_t
+   */
+  uint64_t getIncrement() const { return increment_; }
+
+  /**
+   * @brief Continue exactly where a generator left off
+   *
+   * @param state from getState
+   * @param increment from getIncrement
+   */
+  void restore(uint64_t state, uint64_t increment) {
+    state_ = state;
+    increment_ = increment | 1u;
+  }
+
+  uint32_t operator()() { return next(); }
+  static constexpr uint32_t min() { return 0; }
+  static constexpr uint32_t max() {
+    return std::numeric_limits<uint32_t>::max();
+  }
+
+ private:
+  static constexpr uint64_t MULTIPLIER = 6364136223846793005ULL;
+
+  uint64_t state_ = 0;
+  uint64_t increment_ = 1;
+};
+
+#endif  // SRC_RANDOM_HPP_
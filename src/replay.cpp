@@ -0,0 +1,51 @@
+#include "replay.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "playerAI.hpp"
+#include "snapshot.hpp"
+
+Replay::Replay(std::shared_ptr<GameState> gameState,
+               std::shared_ptr<const Journal> journal)
+    : gameState_(std::move(gameState)), journal_(std::move(journal)) {
+  const std::vector<JournalPlayer>& players = journal_->getPlayers();
+  for (size_t i = 0; i < players.size(); i++) {
+    if (players[i].isComputer) {
+      auto player =
+          std::make_shared<PlayerAI>(players[i].color, i + 1, gameState_);
+      player->addSharedPtr(player);
+      player->setTurnDelay(std::chrono::milliseconds(0));
+      gameState_->addPlayer(player);
+    } else {
+      gameState_->addPlayer(std::make_shared<Player>(players[i].color, i + 1));
+    }
+  }
+
+  SnapshotReader reader(journal_->getSnapshot());
+  gameState_->readSnapshot(reader);
+}
+
+bool Replay::stepTurn() {
+  const std::vector<Action>& actions = journal_->getActions();
+  if (isFinished()) return false;
+  while (position_ < actions.size()) {
+    const Action& action = actions[position_++];
+    gameState_->applyAction(action);
+    if (action.type == NEXT_TURN) break;
+  }
+  return true;
+}
+
+void Replay::run() {
+  const std::vector<Action>& actions = journal_->getActions();
+  while (position_ < actions.size()) {
+    gameState_->applyAction(actions[position_++]);
+  }
+}
+
+bool Replay::isFinished() const {
+  return position_ == journal_->getActions().size();
+}
+
+size_t Replay::getPosition() const { return position_; }
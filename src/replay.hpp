@@ -0,0 +1,70 @@
+#ifndef SRC_REPLAY_HPP_
+#define SRC_REPLAY_HPP_
+
+#include <cstddef>
+#include <memory>
+
+#include "gamestate.hpp"
+#include "journal.hpp"
+
+/**
+ * @brief Plays a journaled match back by applying its actions to a game.
+ *
+ * The AI is not consulted, its decisions come from the journal, so a replay
+ * runs as fast as the game can apply actions. It can be run to the end in one
+ * go or a turn at a time, e.g. to render it at a chosen pace.
+ */
+class Replay {
+ public:
+  /**
+   * @brief Sets a game up as the journaled match started
+   *
+   * The players of the journal are added to the game, AI players as PlayerAI
+   * and the others as Player, then the snapshot the journal begins with is
+   * restored.
+   *
+   * @param gameState a game without players
+   * @param journal
+   * @throws std::invalid_argument if the journal's snapshot is malformed
+   */
+  Replay(std::shared_ptr<GameState> gameState,
+         std::shared_ptr<const Journal> journal);
+
+  /**
+   * @brief Applies the actions of the current turn, up to and including the
+   * change to the next turn
+   *
+   * @return true if an action was applied, false if the replay is finished
+   * @throws std::invalid_argument if an action does not fit the game
+   */
+  bool stepTurn();
+
+  /**
+   * @brief Applies all remaining actions
+   *
+   * @throws std::invalid_argument if an action does not fit the game
+   */
+  void run();
+
+  /**
+   * @brief Check if all actions have been applied
+   *
+   * @return true
+   * @return false
+   */
+  bool isFinished() const;
+
+  /**
+   * @brief Get the number of actions applied so far
+   *
+   * @return size_t
+   */
+  size_t getPosition() const;
+
+ private:
+  std::shared_ptr<GameState> gameState_;
+  std::shared_ptr<const Journal> journal_;
+  size_t position_ = 0;
+};
+
+#endif  // SRC_REPLAY_HPP_
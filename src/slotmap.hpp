@@ -0,0 +1,198 @@
+#ifndef SRC_SLOTMAP_HPP_
+#define SRC_SLOTMAP_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Generational handle to an element of a SlotMap.
+ *
+ * A handle stays valid until the element it refers to is erased, no matter how
+ * many other elements are inserted or erased in the meantime. Once its element
+ * is gone the handle is stale and never resolves to another element.
+ */
+struct SlotHandle {
+  uint32_t slot = UINT32_MAX;
+  uint32_t generation = 0;
+
+  bool operator==(const SlotHandle& other) const {
+    return slot == other.slot && generation == other.generation;
+  }
+  bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+  bool operator<(const SlotHandle& other) const {
+    return slot < other.slot ||
+           (slot == other.slot && generation < other.generation);
+  }
+};
+
+/**
+ * @brief Container with stable handles, O(1) insert, lookup and erase, and
+ * contiguous storage for iteration.
+ *
+ * Elements live densely packed in a std::vector. Erasing moves the last element
+ * into the hole, so the order of iteration is not preserved and pointers or
+ * iterators into the container are invalidated like those of a std::vector.
+ * Handles are not: they go through a slot table that follows the moves.
+ *
+ * @tparam T element type
+ */
+template <typename T>
+class SlotMap {
+ public:
+  using Handle = SlotHandle;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  /**
+   * @brief Inserts an element
+   *
+   * @param value
+   * @return Handle of the new element
+   */
+  Handle insert(T value) {
+    uint32_t slot;
+    if (freeSlots_.empty()) {
+      slot = slots_.size();
+      slots_.push_back(Slot());
+    } else {
+      slot = freeSlots_.back();
+      freeSlots_.pop_back();
+    }
+
+    slots_[slot].dense = values_.size();
+    values_.push_back(std::move(value));
+    denseToSlot_.push_back(slot);
+    return Handle{slot, slots_[slot].generation};
+  }
+
+  /**
+   * @brief Erases the element a handle refers to
+   *
+   * @param handle
+   * @return false if the handle was stale
+   */
+  bool erase(Handle handle) {
+    if (!contains(handle)) return false;
+
+    uint32_t dense = slots_[handle.slot].dense;
+    uint32_t last = values_.size() - 1;
+    if (dense != last) {
+      values_[dense] = std::move(values_[last]);
+      denseToSlot_[dense] = denseToSlot_[last];
+      slots_[denseToSlot_[dense]].dense = dense;
+    }
+    values_.pop_back();
+    denseToSlot_.pop_back();
+
+    slots_[handle.slot].generation++;
+    freeSlots_.push_back(handle.slot);
+    return true;
+  }
+
+  /**
+   * @brief Inserts an erased element again under the handle it had
+   *
+   * Meant for undoing an erase. The element is appended, so the order of
+   * iteration may differ from the one before the erase.
+   *
+   * @param handle handle of the erased element
+   * @param value
+   * @return false if the handle was not erased, or its slot has been reused
+   */
+  bool restore(Handle handle, T value) {
+    if (handle.slot >= slots_.size() ||
+        slots_[handle.slot].generation != handle.generation + 1)
+      return false;
+    // The slot is usually the last one freed
+    auto it = std::find(freeSlots_.rbegin(), freeSlots_.rend(), handle.slot);
+    if (it == freeSlots_.rend()) return false;
+    freeSlots_.erase(std::next(it).base());
+
+    slots_[handle.slot].generation = handle.generation;
+    slots_[handle.slot].dense = values_.size();
+    values_.push_back(std::move(value));
+    denseToSlot_.push_back(handle.slot);
+    return true;
+  }
+
+  /**
+   * @brief Check if a handle still refers to an element
+   *
+   * @param handle
+   * @return true if the element has not been erased
+   */
+  bool contains(Handle handle) const {
+    // Erasing bumps the generation of a slot, so a matching generation means
+    // the slot is occupied by the element the handle was issued for
+    return handle.slot < slots_.size() &&
+           slots_[handle.slot].generation == handle.generation;
+  }
+
+  /**
+   * @brief Resolves a handle
+   *
+   * @param handle
+   * @return Pointer to the element, nullptr if the handle is stale
+   */
+  T* get(Handle handle) {
+    return contains(handle) ? &values_[slots_[handle.slot].dense] : nullptr;
+  }
+  const T* get(Handle handle) const {
+    return contains(handle) ? &values_[slots_[handle.slot].dense] : nullptr;
+  }
+
+  /**
+   * @brief Get the handle of the element at a position of the dense storage
+   *
+   * @param dense position in [0, size())
+   * @return Handle
+   */
+  Handle handleAt(int dense) const {
+    uint32_t slot = denseToSlot_[dense];
+    return Handle{slot, slots_[slot].generation};
+  }
+
+  /**
+   * @brief Removes all elements and invalidates all handles
+   *
+   */
+  void clear() {
+    for (int dense = values_.size() - 1; dense >= 0; dense--) {
+      erase(handleAt(dense));
+    }
+  }
+
+  /**
+   * @brief Get the densely packed elements
+   *
+   * @return const std::vector<T>&
+   */
+  const std::vector<T>& values() const { return values_; }
+
+  T& operator[](int dense) { return values_[dense]; }
+  const T& operator[](int dense) const { return values_[dense]; }
+
+  int size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+
+  iterator begin() { return values_.begin(); }
+  iterator end() { return values_.end(); }
+  const_iterator begin() const { return values_.begin(); }
+  const_iterator end() const { return values_.end(); }
+
+ private:
+  struct Slot {
+    uint32_t dense = 0;
+    uint32_t generation = 0;
+  };
+
+  std::vector<T> values_;
+  std::vector<uint32_t> denseToSlot_;
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> freeSlots_;
+};
+
+#endif  // SRC_SLOTMAP_HPP_
@@ -0,0 +1,63 @@
+#include "snapshot.hpp"
+
+#include <stdexcept>
+
+void SnapshotWriter::writeU8(uint8_t value) { data_.push_back(value); }
+
+void SnapshotWriter::writeU32(uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    data_.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void SnapshotWriter::writeI32(int32_t value) {
+  writeU32(static_cast<uint32_t>(value));
+}
+
+void SnapshotWriter::writeU64(uint64_t value) {
+  writeU32(static_cast<uint32_t>(value));
+  writeU32(static_cast<uint32_t>(value >> 32));
+}
+
+void SnapshotWriter::writeBytes(const uint8_t* bytes, size_t size) {
+  data_.insert(data_.end(), bytes, bytes + size);
+}
+
+const std::vector<uint8_t>& SnapshotWriter::getData() const { return data_; }
+
+SnapshotReader::SnapshotReader(const uint8_t* data, size_t size)
+    : data_(data), size_(size) {}
+
+SnapshotReader::SnapshotReader(const std::vector<uint8_t>& data)
+    : SnapshotReader(data.data(), data.size()) {}
+
+uint8_t SnapshotReader::readU8() { return *readBytes(1); }
+
+uint32_t SnapshotReader::readU32() {
+  const uint8_t* bytes = readBytes(4);
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(bytes[i]) << 8 * i;
+  return value;
+}
+
+int32_t SnapshotReader::readI32() { return static_cast<int32_t>(readU32()); }
+
+uint64_t SnapshotReader::readU64() {
+  uint64_t low = readU32();
+  uint64_t high = readU32();
+  return low | high << 32;
+}
+
+const uint8_t* SnapshotReader::readBytes(size_t size) {
+  if (size > size_ - position_)
+    throw std::invalid_argument("Snapshot ends unexpectedly");
+  const uint8_t* bytes = data_ + position_;
+  position_ += size;
+  return bytes;
+}
+
+SnapshotReader SnapshotReader::readBlock(size_t size) {
+  return SnapshotReader(readBytes(size), size);
+}
+
+bool SnapshotReader::atEnd() const { return position_ == size_; }
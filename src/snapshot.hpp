@@ -0,0 +1,103 @@
+#ifndef SRC_SNAPSHOT_HPP_
+#define SRC_SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Appends values to a binary snapshot.
+ *
+ * Integers are written little-endian with a fixed width, so snapshots can be
+ * read back on any platform. The layout of a snapshot is defined by the code
+ * writing it, see GameState::writeSnapshot.
+ */
+class SnapshotWriter {
+ public:
+  void writeU8(uint8_t value);
+  void writeU32(uint32_t value);
+  void writeI32(int32_t value);
+  void writeU64(uint64_t value);
+
+  /**
+   * @brief Appends raw bytes, e.g. a map layer
+   *
+   * @param bytes
+   * @param size
+   */
+  void writeBytes(const uint8_t* bytes, size_t size);
+
+  /**
+   * @brief Get everything written so far
+   *
+   * @return const std::vector<uint8_t>&
+   */
+  const std::vector<uint8_t>& getData() const;
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+/**
+ * @brief Reads values back from a binary snapshot in the order they were
+ * written.
+ *
+ * The reader does not own the bytes, they have to outlive it.
+ */
+class SnapshotReader {
+ public:
+  /**
+   * @brief Construct a reader over a snapshot
+   *
+   * @param data
+   * @param size
+   */
+  SnapshotReader(const uint8_t* data, size_t size);
+
+  /**
+   * @brief Construct a reader over a snapshot
+   *
+   * @param data
+   */
+  explicit SnapshotReader(const std::vector<uint8_t>& data);
+
+  /**
+   * @throws std::invalid_argument if the snapshot ends before the value
+   */
+  uint8_t readU8();
+  uint32_t readU32();
+  int32_t readI32();
+  uint64_t readU64();
+
+  /**
+   * @brief Get the next bytes without copying them
+   *
+   * @param size
+   * @return const uint8_t* pointer into the snapshot
+   * @throws std::invalid_argument if the snapshot ends before size bytes
+   */
+  const uint8_t* readBytes(size_t size);
+
+  /**
+   * @brief Splits off the next bytes as a reader of their own
+   *
+   * @param size
+   * @return SnapshotReader over the next size bytes
+   * @throws std::invalid_argument if the snapshot ends before size bytes
+   */
+  SnapshotReader readBlock(size_t size);
+
+  /**
+   * @brief Check if everything has been read
+   *
+   * @return true if no bytes are left
+   */
+  bool atEnd() const;
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+#endif  // SRC_SNAPSHOT_HPP_
@@ -0,0 +1,46 @@
+#include "textcache.hpp"
+
+namespace {
+
+uint32_t packColor(sf::Color color) {
+  return (uint32_t(color.r) << 24) | (color.g << 16) | (color.b << 8) |
+         color.a;
+}
+
+}  // namespace
+
+sf::Text& TextCache::get(const sf::Font& font, const std::string& string,
+                         unsigned int charSize, sf::Color fillColor,
+                         float outlineThickness, sf::Color outlineColor) {
+  Key key(string, &font, charSize, packColor(fillColor), outlineThickness,
+          packColor(outlineColor));
+  auto it = texts_.find(key);
+  if (it != texts_.end()) {
+    it->second.isUsed = true;
+    return it->second.text;
+  }
+
+  Entry& entry = texts_[key];
+  entry.text.setFont(font);
+  entry.text.setString(string);
+  entry.text.setCharacterSize(charSize);
+  entry.text.setFillColor(fillColor);
+  entry.text.setOutlineThickness(outlineThickness);
+  entry.text.setOutlineColor(outlineColor);
+  // Measuring builds the glyph quads now, drawing reuses them from then on
+  entry.text.getLocalBounds();
+  return entry.text;
+}
+
+void TextCache::endFrame() {
+  for (auto it = texts_.begin(); it != texts_.end();) {
+    if (it->second.isUsed) {
+      it->second.isUsed = false;
+      ++it;
+    } else {
+      it = texts_.erase(it);
+    }
+  }
+}
+
+size_t TextCache::size() const { return texts_.size(); }
@@ -0,0 +1,64 @@
+#ifndef SRC_TEXTCACHE_HPP_
+#define SRC_TEXTCACHE_HPP_
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+
+/**
+ * @brief Keeps the sf::Text objects of the labels drawn every frame, so a
+ * string is only laid out again when its content or style changes.
+ *
+ * Setting the string of an sf::Text throws away its glyph quads, which are
+ * rebuilt the next time the text is measured or drawn. Labels like the
+ * resource counters stay the same for many frames, so the cache hands out
+ * the same sf::Text for the same content and style. Callers only position it,
+ * which does not touch the glyphs.
+ *
+ * Texts that were not asked for during a frame are dropped by endFrame, so
+ * the cache only holds what is on screen.
+ */
+class TextCache {
+ public:
+  /**
+   * @brief Get the text for a string in a style, laid out on first use
+   *
+   * The returned text stays valid until endFrame. It may be moved around, the
+   * same text is handed out again for the same string and style.
+   *
+   * @param font
+   * @param string
+   * @param charSize
+   * @param fillColor
+   * @param outlineThickness
+   * @param outlineColor
+   * @return sf::Text&
+   */
+  sf::Text& get(const sf::Font& font, const std::string& string,
+                unsigned int charSize, sf::Color fillColor,
+                float outlineThickness = 0,
+                sf::Color outlineColor = sf::Color::Black);
+
+  /**
+   * @brief Drops the texts not used since the last call
+   *
+   */
+  void endFrame();
+
+  size_t size() const;
+
+ private:
+  using Key = std::tuple<std::string, const sf::Font*, unsigned int, uint32_t,
+                         float, uint32_t>;
+
+  struct Entry {
+    sf::Text text;
+    bool isUsed = true;
+  };
+
+  std::map<Key, Entry> texts_;
+};
+
+#endif  // SRC_TEXTCACHE_HPP_
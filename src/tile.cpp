@@ -1,7 +1,16 @@
 #include "tile.hpp"
 
-Tile::Tile(int x, int y, TileType type, std::shared_ptr<Player> owner)
-    : Selectable("Tile"), x_(x), y_(y), type_(type), owner_(owner) {}
+bool canTraverse(MovementClass movement, TileType type) {
+  return type == GRASS || (movement == AMPHIBIOUS && type == WATER);
+}
+
+Tile::Tile(int x, int y, TileType type, PlayerIndex owner)
+    : Selectable("Tile"),
+      x_(x),
+      y_(y),
+      type_(type),
+      owner_(owner),
+      occupied_(false) {}
 
 int Tile::getX() const { return x_; }
 
@@ -15,13 +24,13 @@ TileType Tile::getType() const { return type_; }
 
 void Tile::setType(TileType type) { type_ = type; }
 
-std::shared_ptr<Player> Tile::setOwner(std::shared_ptr<Player> player) {
-  std::shared_ptr<Player> currentOwner = owner_;
+PlayerIndex Tile::setOwner(PlayerIndex player) {
+  PlayerIndex currentOwner = owner_;
   owner_ = player;
   return currentOwner;
 }
 
-std::shared_ptr<Player> Tile::getOwner() const { return owner_; }
+PlayerIndex Tile::getOwner() const { return owner_; }
 
 void Tile::setOccupied(bool occupy) { occupied_ = occupy; }
 
@@ -30,9 +39,9 @@ bool Tile::isOccupied() const { return occupied_; }
 std::vector<std::string> Tile::getInfo() const {
   std::vector<std::string> lines;
   std::string ownerName = "Owner: None";
-  if (owner_ != nullptr) {
+  if (owner_ != NO_PLAYER) {
     ownerName = "Owner: Player ";
-    ownerName += std::to_string(owner_->getID());
+    ownerName += std::to_string(owner_ + 1);
   }
   lines.push_back(ownerName);
   return lines;
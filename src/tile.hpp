@@ -9,10 +9,24 @@
 
 enum TileType { GRASS, WATER, ROCK, PLACEHOLDER };
 
+// Which terrain a unit can cross. Units of the same class can reach the same
+// tiles, so paths are shared per class rather than per army type.
+enum MovementClass { LAND, AMPHIBIOUS };
+constexpr int NUM_MOVEMENT_CLASSES = 2;
+
+/**
+ * @brief Check if units of a movement class can enter a tile type
+ *
+ * @param movement
+ * @param type
+ * @return true
+ * @return false
+ */
+bool canTraverse(MovementClass movement, TileType type);
+
 class Tile : public Selectable {
  public:
-  Tile(int x, int y, TileType type = GRASS,
-       std::shared_ptr<Player> owner = nullptr);
+  Tile(int x, int y, TileType type = GRASS, PlayerIndex owner = NO_PLAYER);
 
   /**
    * get the X coordinate of this tile.
@@ -46,16 +60,16 @@ class Tile : public Selectable {
 
   /**
    * set the owner of this tile.
-   * @param player pointer to the new tile owner.
+   * @param player index of the new tile owner.
    * @return The prior owner.
    **/
-  std::shared_ptr<Player> setOwner(std::shared_ptr<Player> player);
+  PlayerIndex setOwner(PlayerIndex player);
 
   /**
    * get the owner of this tile.
-   * @return This tile's owner.
+   * @return This tile's owner, NO_PLAYER if the tile is unclaimed.
    **/
-  std::shared_ptr<Player> getOwner() const;
+  PlayerIndex getOwner() const;
 
   /**
    * set the occupation status of this tile.
@@ -75,7 +89,7 @@ class Tile : public Selectable {
   int x_;
   int y_;
   TileType type_;
-  std::shared_ptr<Player> owner_;
+  PlayerIndex owner_;
   bool occupied_;
 };
 
@@ -0,0 +1,110 @@
+#include "tilelayer.hpp"
+
+#include <algorithm>
+
+#include "uimanager.hpp"
+
+namespace {
+
+const sf::Color OUTLINE_COLOR(200, 200, 200);
+
+}  // namespace
+
+sf::Color getTerrainColor(TileType type) {
+  switch (type) {
+    case WATER:
+      return sf::Color(45, 110, 210);
+    case ROCK:
+      return sf::Color(210, 210, 210);
+    case PLACEHOLDER:
+      return sf::Color(128, 128, 128);
+    case GRASS:
+    default:
+      return sf::Color(155, 255, 155);
+  }
+}
+
+TileLayer::TileLayer() : pending_(sf::Points) {
+  // One tile pitch with the outline on its border and a transparent inside,
+  // the inside being where the tile's texel shows through
+  int pitch = TILE_SIZE + OUTLINE_SIZE;
+  sf::Image grid;
+  grid.create(pitch, pitch, sf::Color::Transparent);
+  for (int i = 0; i < pitch; i++) {
+    grid.setPixel(i, 0, OUTLINE_COLOR);
+    grid.setPixel(i, pitch - 1, OUTLINE_COLOR);
+    grid.setPixel(0, i, OUTLINE_COLOR);
+    grid.setPixel(pitch - 1, i, OUTLINE_COLOR);
+  }
+  gridTexture_.loadFromImage(grid);
+  gridTexture_.setRepeated(true);
+}
+
+bool TileLayer::reset(int numCols, int numRows) {
+  pending_.clear();
+  if (numCols != numCols_ || numRows != numRows_) {
+    numCols_ = 0;
+    numRows_ = 0;
+    if (numCols <= 0 || numRows <= 0 ||
+        numCols > sf::Texture::getMaximumSize() ||
+        numRows > sf::Texture::getMaximumSize() ||
+        !texture_.create(numCols, numRows))
+      return false;
+    numCols_ = numCols;
+    numRows_ = numRows;
+  }
+  texture_.clear(sf::Color::Transparent);
+  texture_.display();
+  return true;
+}
+
+void TileLayer::setTile(int x, int y, sf::Color color) {
+  if (x < 0 || y < 0 || x >= numCols_ || y >= numRows_) return;
+  // The center of the texel, so the point covers exactly that texel
+  pending_.append(sf::Vertex(sf::Vector2f(x + .5f, y + .5f), color));
+}
+
+void TileLayer::draw(sf::RenderTarget& target, sf::Vector2f position) {
+  draw(target, position, sf::IntRect(0, 0, numCols_, numRows_));
+}
+
+void TileLayer::draw(sf::RenderTarget& target, sf::Vector2f position,
+                     sf::IntRect tiles) {
+  if (numCols_ == 0) return;
+
+  if (pending_.getVertexCount() > 0) {
+    // Overwrite the texels instead of blending, so tiles can become
+    // transparent again
+    sf::RenderStates states;
+    states.blendMode = sf::BlendNone;
+    texture_.draw(pending_, states);
+    texture_.display();
+    pending_.clear();
+  }
+
+  int left = std::clamp(tiles.left, 0, numCols_);
+  int top = std::clamp(tiles.top, 0, numRows_);
+  int right = std::clamp(tiles.left + tiles.width, left, numCols_);
+  int bottom = std::clamp(tiles.top + tiles.height, top, numRows_);
+  if (left == right || top == bottom) return;
+
+  int pitch = TILE_SIZE + OUTLINE_SIZE;
+  sf::Vector2f corner(position.x - 1 + left * pitch,
+                      position.y - 1 + top * pitch);
+  // The texel of a tile covers its pitch, the outline is drawn over its edges
+  sf::Sprite sprite(texture_.getTexture(),
+                    sf::IntRect(left, top, right - left, bottom - top));
+  sprite.setPosition(corner);
+  sprite.setScale(pitch, pitch);
+  target.draw(sprite);
+
+  // The grid repeats every pitch, so it starts at 0 wherever it is drawn
+  sf::Sprite grid(gridTexture_, sf::IntRect(0, 0, (right - left) * pitch,
+                                            (bottom - top) * pitch));
+  grid.setPosition(corner);
+  target.draw(grid);
+}
+
+int TileLayer::getNumCols() const { return numCols_; }
+
+int TileLayer::getNumRows() const { return numRows_; }
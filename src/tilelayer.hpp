@@ -0,0 +1,82 @@
+#ifndef SRC_TILELAYER_HPP_
+#define SRC_TILELAYER_HPP_
+
+#include <SFML/Graphics.hpp>
+
+#include "tile.hpp"
+
+/**
+ * @brief Get the color a tile of a terrain type is filled with
+ *
+ * @param type
+ * @return sf::Color
+ */
+sf::Color getTerrainColor(TileType type);
+
+/**
+ * @brief One fill color per map tile, kept in an off-screen texture and drawn
+ * as a single scaled sprite with the tile grid on top.
+ *
+ * The texture holds one texel per tile, column x and row y of the map being
+ * texel x, y, so even large maps fit into a texture. Drawing scales it up to
+ * the tile size with nearest filtering and overlays a repeated texture with
+ * the tile outlines. Tiles are only re-rendered when their color is set, the
+ * changes are collected and written to the texture in one draw call.
+ */
+class TileLayer {
+ public:
+  TileLayer();
+
+  /**
+   * @brief Resizes the layer to a map and clears every tile
+   *
+   * @param numCols
+   * @param numRows
+   * @return false if the map is larger than the biggest texture supported
+   */
+  bool reset(int numCols, int numRows);
+
+  /**
+   * @brief Sets the fill color of a tile, the change shows on the next draw
+   *
+   * @param x
+   * @param y
+   * @param color sf::Color::Transparent to leave the tile empty
+   */
+  void setTile(int x, int y, sf::Color color);
+
+  /**
+   * @brief Draws the layer with the top left tile at position. The outline
+   * around a tile lies one pixel outside of it, like that of an
+   * sf::RectangleShape.
+   *
+   * @param target
+   * @param position
+   */
+  void draw(sf::RenderTarget& target, sf::Vector2f position);
+
+  /**
+   * @brief Draws only some of the tiles, at the place they have when the
+   * whole layer is drawn at position
+   *
+   * @param target
+   * @param position
+   * @param tiles columns and rows to draw, clipped to the layer
+   */
+  void draw(sf::RenderTarget& target, sf::Vector2f position,
+            sf::IntRect tiles);
+
+  int getNumCols() const;
+  int getNumRows() const;
+
+ private:
+  int numCols_ = 0;
+  int numRows_ = 0;
+  sf::RenderTexture texture_;
+  // Tile colors set since the last draw, one point per tile
+  sf::VertexArray pending_;
+  // A single tile's outline, repeated over the map
+  sf::Texture gridTexture_;
+};
+
+#endif  // SRC_TILELAYER_HPP_
@@ -0,0 +1,31 @@
+// Converts a text map file to the binary map format, which loads without
+// parsing and is memory-mapped at startup.
+//
+// Usage: mapconvert INPUT OUTPUT
+//   INPUT   text map, with or without a header
+//   OUTPUT  binary map to write, by convention ending in .s8m
+
+#include <exception>
+#include <iostream>
+
+#include "mapfile.hpp"
+#include "mappedmap.hpp"
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: mapconvert INPUT OUTPUT" << std::endl;
+    return 1;
+  }
+
+  try {
+    MapFile map = MapFile::load(argv[1]);
+    MappedMap::save(argv[2], map.getNumCols(), map.getNumRows(),
+                    map.toTerrain());
+    std::cout << "Wrote " << map.getNumCols() << "x" << map.getNumRows()
+              << " map to " << argv[2] << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
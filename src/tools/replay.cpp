@@ -0,0 +1,75 @@
+// Plays a journaled match back without a window, as fast as the actions can
+// be applied, and prints how it ended. Journals are recorded by selfplay
+// --journal.
+//
+// Usage: replay [-q] JOURNAL
+//   -q, --quiet   only print the timing
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "gamestate.hpp"
+#include "journal.hpp"
+#include "replay.hpp"
+
+int main(int argc, char* argv[]) {
+  bool quiet = false;
+  std::string filename;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-q" || arg == "--quiet") {
+      quiet = true;
+    } else if (filename.empty()) {
+      filename = arg;
+    } else {
+      filename.clear();
+      break;
+    }
+  }
+  if (filename.empty()) {
+    std::cerr << "Usage: replay [-q] JOURNAL" << std::endl;
+    return 1;
+  }
+
+  try {
+    auto journal = std::make_shared<const Journal>(Journal::load(filename));
+    auto gs = std::make_shared<GameState>();
+
+    auto start = std::chrono::steady_clock::now();
+    Replay replay(gs, journal);
+    replay.run();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << "replayed " << replay.getPosition() << " actions over "
+              << journal->getTurnCount() << " turns in " << elapsed.count()
+              << " s" << std::endl;
+    if (quiet) return 0;
+
+    std::cout << "seed " << journal->getSeed() << " turn " << gs->getTurn()
+              << " winner ";
+    if (gs->getWinner()) {
+      std::cout << "player " << gs->getWinner()->getIndex() + 1 << std::endl;
+    } else {
+      std::cout << "none" << std::endl;
+    }
+    for (size_t i = 0; i < journal->getPlayers().size(); i++) {
+      const std::shared_ptr<Player>& player = gs->getPlayer(i);
+      Resources resources = player->getResources();
+      Resources income = gs->getIncome(player);
+      std::cout << "player " << i + 1 << ": food " << resources.food
+                << " wood " << resources.wood << " gold " << resources.gold
+                << " stone " << resources.stone << ", income food "
+                << income.food << " wood " << income.wood << " gold "
+                << income.gold << " stone " << income.stone
+                << ", tiles " << gs->getClaimedTileCount(player) << std::endl;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,307 @@
+// Plays PlayerAI against PlayerAI without a window, many matches at once, and
+// prints who won, how long it took and what the players ended up with.
+//
+// Usage: selfplay [options]
+//   -n, --matches N     number of matches to play (default 100)
+//   -j, --threads N     worker threads (default: one per core)
+//   -s, --seed N        base seed, match i is seeded from it and i (default 1)
+//   -m, --map FILE      text or binary map to play on, repeat to rotate
+//                       through several maps (default maps/example1.txt)
+//   -t, --max-turns N   call a match a draw after this many turns (default 500)
+//   -J, --journal PATH  record the journal of match i to PATH<i>.s8j, to be
+//                       played back with the replay tool
+//   -q, --quiet         only print the summary
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gamestate.hpp"
+#include "mapfile.hpp"
+#include "mappedmap.hpp"
+#include "playerAI.hpp"
+
+namespace {
+
+constexpr int NUM_PLAYERS = 2;
+
+struct Options {
+  int matches = 100;
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  uint64_t seed = 1;
+  std::vector<std::string> maps;
+  int maxTurns = 500;
+  std::string journal;
+  bool quiet = false;
+};
+
+// Binary maps stay mapped and are copied into every match
+struct Map {
+  std::string name;
+  MapFile file;
+  std::unique_ptr<MappedMap> binary;
+
+  int getNumCols() const {
+    return binary ? binary->getNumCols() : file.getNumCols();
+  }
+  int getNumRows() const {
+    return binary ? binary->getNumRows() : file.getNumRows();
+  }
+};
+
+struct MatchResult {
+  int map = 0;
+  uint64_t seed = 0;
+  // index of the winning player, -1 for a draw
+  int winner = -1;
+  int turns = 0;
+  Resources resources[NUM_PLAYERS];
+  Resources income[NUM_PLAYERS];
+};
+
+void printUsage() {
+  std::cerr << "Usage: selfplay [-n matches] [-j threads] [-s seed] "
+               "[-m map]... [-t max-turns] [-J journal-path] [-q]"
+            << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-q" || arg == "--quiet") {
+      options.quiet = true;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    std::string value = argv[++i];
+    try {
+      if (arg == "-n" || arg == "--matches") {
+        options.matches = std::stoi(value);
+      } else if (arg == "-j" || arg == "--threads") {
+        options.threads = std::stoi(value);
+      } else if (arg == "-s" || arg == "--seed") {
+        options.seed = std::stoull(value);
+      } else if (arg == "-m" || arg == "--map") {
+        options.maps.push_back(value);
+      } else if (arg == "-t" || arg == "--max-turns") {
+        options.maxTurns = std::stoi(value);
+      } else if (arg == "-J" || arg == "--journal") {
+        options.journal = value;
+      } else {
+        return false;
+      }
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+  if (options.maps.empty()) options.maps.push_back("maps/example1.txt");
+  return options.matches >= 0 && options.threads > 0 && options.maxTurns > 0;
+}
+
+// Spreads consecutive match numbers over unrelated seeds (SplitMix64)
+uint64_t mixSeed(uint64_t seed) {
+  seed += 0x9e3779b97f4a7c15ULL;
+  seed = (seed ^ (seed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  seed = (seed ^ (seed >> 27)) * 0x94d049bb133111ebULL;
+  return seed ^ (seed >> 31);
+}
+
+// Sets up a match the same way main.cpp does: a townhall for each player with
+// the tiles around it claimed, on opposite corners of the map. The match is
+// journaled to journalFile unless it is empty.
+MatchResult playMatch(const Map& map, int mapIndex, uint64_t seed,
+                      int maxTurns, const std::string& journalFile) {
+  auto gs = std::make_shared<GameState>();
+  gs->setSeed(seed);
+  std::vector<std::shared_ptr<PlayerAI>> players;
+  const Color colors[NUM_PLAYERS] = {Color(0, 128, 128), Color(0, 0, 128)};
+  for (int i = 0; i < NUM_PLAYERS; i++) {
+    auto player = std::make_shared<PlayerAI>(colors[i], i + 1, gs);
+    player->addSharedPtr(player);
+    player->setTurnDelay(std::chrono::milliseconds(0));
+    gs->addPlayer(player);
+    players.push_back(player);
+  }
+
+  if (map.binary) {
+    gs->loadMap(*map.binary);
+  } else {
+    gs->loadMap(map.file);
+  }
+
+  int numCols = map.getNumCols();
+  int numRows = map.getNumRows();
+  const std::pair<int, int> starts[NUM_PLAYERS] = {
+      {std::min(4, numCols - 1), std::min(4, numRows - 1)},
+      {std::max(0, numCols - 7), std::max(0, numRows - 5)}};
+  for (int i = 0; i < NUM_PLAYERS; i++) {
+    auto [x, y] = starts[i];
+    gs->claimTile(x, y, players[i]);
+    for (auto [dx, dy] : {std::make_pair(-1, 0), std::make_pair(1, 0),
+                          std::make_pair(0, -1), std::make_pair(0, 1)}) {
+      if (gs->areCoordinatesValid(x + dx, y + dy))
+        gs->claimTile(x + dx, y + dy, players[i]);
+    }
+    gs->addTownhall(TownHall(i + 1, 1, players[i]->getIndex(), x, y));
+  }
+
+  gs->setActivePlayerID(players[gs->getTurn() % NUM_PLAYERS]->getID());
+  std::shared_ptr<Journal> journal;
+  if (!journalFile.empty()) {
+    journal = std::make_shared<Journal>();
+    gs->setJournal(journal);
+  }
+  int firstTurn = gs->getTurn();
+  while (!gs->getWinner() && gs->getTurn() - firstTurn < maxTurns) gs->tick();
+  if (journal) {
+    try {
+      journal->save(journalFile);
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+    }
+  }
+
+  MatchResult result;
+  result.map = mapIndex;
+  result.seed = seed;
+  result.turns = gs->getTurn() - firstTurn;
+  for (int i = 0; i < NUM_PLAYERS; i++) {
+    if (gs->getWinner() == players[i]) result.winner = i;
+    result.resources[i] = players[i]->getResources();
+    result.income[i] = gs->getIncome(players[i]);
+  }
+  return result;
+}
+
+void addResources(Resources& total, const Resources& resources) {
+  total.food += resources.food;
+  total.wood += resources.wood;
+  total.gold += resources.gold;
+  total.stone += resources.stone;
+}
+
+std::ostream& operator<<(std::ostream& out, const Resources& resources) {
+  return out << "food " << resources.food << " wood " << resources.wood
+             << " gold " << resources.gold << " stone " << resources.stone;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<Map> maps(options.maps.size());
+  for (size_t i = 0; i < maps.size(); i++) {
+    maps[i].name = options.maps[i];
+    try {
+      if (MappedMap::isBinaryMap(options.maps[i])) {
+        maps[i].binary = std::make_unique<MappedMap>(options.maps[i]);
+      } else {
+        maps[i].file = MapFile::load(options.maps[i]);
+      }
+    } catch (const std::exception& e) {
+      std::cerr << "Could not load map: " << e.what() << std::endl;
+      return 1;
+    }
+    if (maps[i].getNumCols() == 0 || maps[i].getNumRows() == 0) {
+      std::cerr << "Could not load map: " << options.maps[i] << " is empty"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  // Workers take the next unplayed match until none are left, so a few long
+  // matches do not hold up the others
+  std::vector<MatchResult> results(options.matches);
+  std::atomic<int> nextMatch(0);
+  auto worker = [&]() {
+    for (int match = nextMatch++; match < options.matches;
+         match = nextMatch++) {
+      int mapIndex = match % maps.size();
+      uint64_t seed = mixSeed(options.seed ^ mixSeed(match));
+      std::string journalFile;
+      if (!options.journal.empty())
+        journalFile = options.journal + std::to_string(match) + ".s8j";
+      results[match] = playMatch(maps[mapIndex], mapIndex, seed,
+                                 options.maxTurns, journalFile);
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < std::min(options.threads, options.matches); i++) {
+    threads.emplace_back(worker);
+  }
+  for (std::thread& thread : threads) thread.join();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  if (!options.quiet) {
+    for (size_t match = 0; match < results.size(); match++) {
+      const MatchResult& r = results[match];
+      std::cout << "match " << match << " map " << maps[r.map].name
+                << " seed " << r.seed << " turns " << r.turns << " winner ";
+      if (r.winner < 0) {
+        std::cout << "draw";
+      } else {
+        std::cout << "player " << r.winner + 1;
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  int wins[NUM_PLAYERS] = {};
+  int draws = 0;
+  long totalTurns = 0;
+  int minTurns = options.maxTurns;
+  int maxTurns = 0;
+  Resources totalResources[NUM_PLAYERS];
+  Resources totalIncome[NUM_PLAYERS];
+  for (int i = 0; i < NUM_PLAYERS; i++) {
+    totalResources[i] = Resources(0, 0, 0, 0);
+    totalIncome[i] = Resources(0, 0, 0, 0);
+  }
+  for (const MatchResult& r : results) {
+    if (r.winner < 0) {
+      draws++;
+    } else {
+      wins[r.winner]++;
+    }
+    totalTurns += r.turns;
+    minTurns = std::min(minTurns, r.turns);
+    maxTurns = std::max(maxTurns, r.turns);
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+      addResources(totalResources[i], r.resources[i]);
+      addResources(totalIncome[i], r.income[i]);
+    }
+  }
+
+  int n = std::max(1, options.matches);
+  std::cout << options.matches << " matches on " << threads.size()
+            << " threads in " << elapsed.count() << " s" << std::endl;
+  std::cout << "turns: avg " << static_cast<double>(totalTurns) / n << " min "
+            << (options.matches ? minTurns : 0) << " max " << maxTurns
+            << std::endl;
+  std::cout << "draws: " << draws << std::endl;
+  for (int i = 0; i < NUM_PLAYERS; i++) {
+    Resources avgResources(
+        totalResources[i].food / n, totalResources[i].wood / n,
+        totalResources[i].gold / n, totalResources[i].stone / n);
+    Resources avgIncome(totalIncome[i].food / n, totalIncome[i].wood / n,
+                        totalIncome[i].gold / n, totalIncome[i].stone / n);
+    std::cout << "player " << i + 1 << ": wins " << wins[i]
+              << ", avg resources " << avgResources << ", avg income "
+              << avgIncome << std::endl;
+  }
+  return 0;
+}
@@ -1,7 +1,6 @@
 #include "townhall.hpp"
 
-TownHall::TownHall(int id, int soldierCost, std::shared_ptr<Player> owner,
-                   int x, int y)
+TownHall::TownHall(int id, int soldierCost, PlayerIndex owner, int x, int y)
     : Selectable("TownHall"),
       id_(id),
       soldierCost_(soldierCost),
@@ -11,7 +10,7 @@ TownHall::TownHall(int id, int soldierCost, std::shared_ptr<Player> owner,
 
 int TownHall::getId() const { return id_; }
 
-std::shared_ptr<Player> TownHall::getOwner() const { return owner_; };
+PlayerIndex TownHall::getOwner() const { return owner_; };
 
 std::string TownHall::getName() const { return getLabel(); }
 
@@ -1,9 +1,9 @@
 #ifndef TOWNHALL_HPP
 #define TOWNHALL_HPP
 
-#include <SFML/Graphics.hpp>
 #include <cmath>
 #include <memory>
+#include <string>
 
 #include "army.hpp"
 #include "player.hpp"
@@ -20,8 +20,7 @@ class TownHall : public Selectable {
    * @param x
    * @param y
    */
-  TownHall(int id, int soldierCost, std::shared_ptr<Player> owner, int x,
-           int y);
+  TownHall(int id, int soldierCost, PlayerIndex owner, int x, int y);
 
   /**
    * @brief Get the ID of the Town Hall.
@@ -40,9 +39,9 @@ class TownHall : public Selectable {
   /**
    * @brief Returns owner of the Townhall.
    *
-   * @return Pointer to player
+   * @return Index of the owning player
    */
-  std::shared_ptr<Player> getOwner() const;
+  PlayerIndex getOwner() const;
 
   /**
    * @brief Returns information about the townhall.
@@ -94,7 +93,7 @@ class TownHall : public Selectable {
  private:
   int id_;
   int soldierCost_;
-  std::shared_ptr<Player> owner_;
+  PlayerIndex owner_;
   std::string label = "Townhall";
   int x_;
   int y_;
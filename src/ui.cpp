@@ -2,7 +2,11 @@
 
 UI::UI(std::shared_ptr<Player> player, std::shared_ptr<GameState> gameState,
        sf::Font font, std::shared_ptr<sf::RenderWindow> window)
-    : player_(player), gameState_(gameState), font(font), window_(window) {
+    : player_(player),
+      gameState_(gameState),
+      mapRenderer_(gameState, player),
+      font(font),
+      window_(window) {
   sf::Font f;
   if (!f.loadFromFile("HackNerdFont-Regular.ttf")) {
     std::cerr << "Error loading font!" << std::endl;
@@ -14,12 +18,15 @@ UI::UI(std::shared_ptr<Player> player, std::shared_ptr<GameState> gameState,
 }
 
 void UI::displayUI() {
+  camera_.setMapSize(gameState_->getNumCols(), gameState_->getNumRows());
   displayMap();
   displayEndRound();
   displayResources();
   displayMenu();
   displaySelected();
   displayInfoBox();
+  // Labels that were not drawn this frame are not needed anymore
+  textCache_.endFrame();
 };
 
 void UI::processMouseButtonPressed(sf::Event event) {
@@ -27,11 +34,11 @@ void UI::processMouseButtonPressed(sf::Event event) {
     std::cout << "End turn pressed" << std::endl;
     gameState_->nextTurn();
   }
-  if (mapArea.contains(event.mouseButton.x, event.mouseButton.y)) {
-    int xPos =
-        (event.mouseButton.x - LEFT_MAP_OFFSET) / (TILE_SIZE + OUTLINE_SIZE);
-    int yPos =
-        (event.mouseButton.y - TOP_MAP_OFFSET) / (TILE_SIZE + OUTLINE_SIZE);
+  camera_.setMapSize(gameState_->getNumCols(), gameState_->getNumRows());
+  int xPos, yPos;
+  if (camera_.getTileAt(
+          *window_, sf::Vector2i(event.mouseButton.x, event.mouseButton.y),
+          xPos, yPos)) {
     processTileSelected(xPos, yPos);
   }
   if (menuArea.contains(event.mouseButton.x, event.mouseButton.y)) {
@@ -42,6 +49,29 @@ void UI::processMouseButtonPressed(sf::Event event) {
   // std::endl;
 };
 
+void UI::processKeyPressed(sf::Event event) {
+  camera_.setMapSize(gameState_->getNumCols(), gameState_->getNumRows());
+  if (camera_.processEvent(event, *window_)) return;
+
+  if (!event.key.control) return;
+  bool isUndo = event.key.code == sf::Keyboard::Z && !event.key.shift;
+  bool isRedo = event.key.code == sf::Keyboard::Y ||
+                (event.key.code == sf::Keyboard::Z && event.key.shift);
+  if (!isUndo && !isRedo) return;
+
+  bool changed = isUndo ? gameState_->undo() : gameState_->redo();
+  if (!changed) return;
+  std::cout << (isUndo ? "Undo" : "Redo") << std::endl;
+  // The selected army may be gone or have moved
+  resetSelected();
+  activeMenu_ = Menu::BUILD;
+}
+
+void UI::processMouseWheelScrolled(sf::Event event) {
+  camera_.setMapSize(gameState_->getNumCols(), gameState_->getNumRows());
+  camera_.processEvent(event, *window_);
+}
+
 // ==============
 //
 // UI ELEMENTS
@@ -50,57 +80,48 @@ void UI::processMouseButtonPressed(sf::Event event) {
 
 void UI::displayResources() {
   auto r = player_->getResources();
+  // income per turn from the player's buildings
+  Resources income = gameState_->getIncome(player_);
+
+  // The labels are only formatted again when one of the numbers changed
+  std::array<int, 8> amounts = {r.wood, income.wood, r.food,  income.food,
+                                r.gold, income.gold, r.stone, income.stone};
+  if (resourceLabels_[0].empty() || amounts != shownAmounts_) {
+    const char* names[] = {"Wood", "Food", "Gold", "Stone"};
+    for (int i = 0; i < resourceLabels_.size(); i++) {
+      std::ostringstream oss;
+      oss << names[i] << ": " << amounts[2 * i] << " (+" << amounts[2 * i + 1]
+          << ")";
+      resourceLabels_[i] = oss.str();
+    }
+    shownAmounts_ = amounts;
+  }
 
-  std::ostringstream oss;
-  oss << "Wood: " << r.wood;
-
-  sf::RectangleShape wood_rectangle =
-      createRect(140, TOP_MAP_OFFSET - 1, 1140, 0, DARK_GRAY, 2, LIGHT_GRAY);
-  sf::Text wood_text = createTextForRect(wood_rectangle, font, oss.str());
-
-  oss.str("");
-  oss << "Food: " << r.food;
-
-  sf::RectangleShape food_rectangle =
-      createRect(140, TOP_MAP_OFFSET - 1, 1000, 0, DARK_GRAY, 2, LIGHT_GRAY);
-  sf::Text food_text = createTextForRect(food_rectangle, font, oss.str());
-
-  oss.str("");
-  oss << "Gold: " << r.gold;
-
-  sf::RectangleShape gold_rectangle =
-      createRect(140, TOP_MAP_OFFSET - 1, 860, 0, DARK_GRAY, 2, LIGHT_GRAY);
-  sf::Text gold_text = createTextForRect(gold_rectangle, font, oss.str());
-
-  oss.str("");
-  oss << "Stone: " << r.stone;
-
-  sf::RectangleShape stone_rectangle =
-      createRect(140, TOP_MAP_OFFSET - 1, 720, 0, DARK_GRAY, 2, LIGHT_GRAY);
-  sf::Text stone_text = createTextForRect(stone_rectangle, font, oss.str());
+  // From right to left: wood, food, gold, stone
+  for (int i = 0; i < resourceLabels_.size(); i++) {
+    sf::RectangleShape rectangle = createRect(
+        140, TOP_MAP_OFFSET - 1, 1140 - 140 * i, 0, DARK_GRAY, 2, LIGHT_GRAY);
+    sf::Text& text =
+        textCache_.get(font, resourceLabels_[i], 14, sf::Color::White);
+    alignTextInRect(text, rectangle);
 
-  window_->draw(wood_rectangle);
-  window_->draw(wood_text);
-  window_->draw(food_rectangle);
-  window_->draw(food_text);
-  window_->draw(gold_rectangle);
-  window_->draw(gold_text);
-  window_->draw(stone_rectangle);
-  window_->draw(stone_text);
+    window_->draw(rectangle);
+    window_->draw(text);
+  }
 };
 
 void UI::displaySelected() {
-  std::ostringstream oss;
   std::string label = "";
-  if (selected_ != nullptr) {
-    label = selected_->getLabel();
+  Selectable* selected = getSelected();
+  if (selected != nullptr) {
+    label = selected->getLabel();
   }
-  oss << "Selected: " << label;
 
   sf::RectangleShape rectangle = createRect(
       436, TOP_MAP_OFFSET - 1, LEFT_MAP_OFFSET + 2, 0, UI_BG, 2, LIGHT_GRAY);
-  sf::Text text = createTextForRect(rectangle, font, oss.str(), 18,
-                                    sf::Color::White, START, CENTER);
+  sf::Text& text =
+      textCache_.get(font, "Selected: " + label, 18, sf::Color::White);
+  alignTextInRect(text, rectangle, START, CENTER);
 
   window_->draw(rectangle);
   window_->draw(text);
@@ -124,62 +145,71 @@ void UI::displayEndRound() {
 
 void UI::displayInfoBox() {
   sf::RectangleShape rectangle;
-  sf::Text title;
 
   std::string name = "Nothing selected";
   std::string label = "Nothing selected";
   std::vector<std::string> content;
-  if (selected_ != nullptr) {
-    name = selected_->getName();
-    label = selected_->getLabel();
-    content = selected_->getInfo();
+  Selectable* selected = getSelected();
+  if (selected != nullptr) {
+    name = selected->getName();
+    label = selected->getLabel();
+    content = selected->getInfo();
   }
   rectangle =
       createRect(LEFT_MAP_OFFSET - 2, 400, 0, 0, DARK_GRAY, 2, LIGHT_GRAY);
-  title = createTextForRect(rectangle, font, label, 24, sf::Color::White,
-                            ORIENTATION::START, ORIENTATION::START);
+  sf::Text& title = textCache_.get(font, label, 24, sf::Color::White);
+  alignTextInRect(title, rectangle, ORIENTATION::START, ORIENTATION::START);
   window_->draw(rectangle);
   window_->draw(title);
-  for (sf::Text text : createTextsForRect(rectangle, font, content, 24,
-                                          sf::Color::White, 52, 12)) {
+  // One line per entry below the title, as createTextsForRect lays them out
+  for (int row = 0; row < content.size(); row++) {
+    float offset = 52 + row * (24 + 12);
+    if (offset >= rectangle.getSize().y) break;
+    sf::Text& text = textCache_.get(font, content[row], 24, sf::Color::White);
+    alignTextInRect(text, rectangle, ORIENTATION::START, ORIENTATION::START);
+    text.move(0, offset);
     window_->draw(text);
   }
 }
 
 void UI::displayMap() {
-  for (auto tile : gameState_->getVisibleTiles(player_)) {
-    // tile is of size 38 and 2*1mm outline on each side
-    drawTile(tile, LEFT_MAP_OFFSET + tile.getX() * (TILE_SIZE + OUTLINE_SIZE),
-             TOP_MAP_OFFSET + tile.getY() * (TILE_SIZE + OUTLINE_SIZE));
-  }
+  // tile is of size 38 and 2*1mm outline on each side, drawn through the
+  // camera at the position it has when the map is neither panned nor zoomed
+  window_->setView(camera_.getView());
+  sf::IntRect tiles = camera_.getVisibleTiles();
+  mapRenderer_.draw(*window_, tiles);
 
   displayHighlightedtiles();
 
-  for (auto building : gameState_->getVisibleBuildings(player_)) {
-    drawBuilding(building,
-                 LEFT_MAP_OFFSET + building.getX() * (TILE_SIZE + OUTLINE_SIZE),
-                 TOP_MAP_OFFSET + building.getY() * (TILE_SIZE + OUTLINE_SIZE));
-  }
-
-  for (auto townhall : gameState_->getVisibleTownhalls(player_)) {
-    drawTownhall(townhall,
-                 LEFT_MAP_OFFSET + townhall.getX() * (TILE_SIZE + OUTLINE_SIZE),
-                 TOP_MAP_OFFSET + townhall.getY() * (TILE_SIZE + OUTLINE_SIZE));
-  }
-
-  for (auto army : gameState_->getVisibleArmies(player_)) {
-    drawArmy(army,
-             LEFT_MAP_OFFSET + army.getLocationX() * (TILE_SIZE + OUTLINE_SIZE),
-             TOP_MAP_OFFSET + army.getLocationY() * (TILE_SIZE + OUTLINE_SIZE));
+  // Only the tiles on screen are looked up in GameState's occupancy grids, so
+  // entities elsewhere on the map cost nothing
+  for (int x = tiles.left; x < tiles.left + tiles.width; x++) {
+    for (int y = tiles.top; y < tiles.top + tiles.height; y++) {
+      bool hasBuilding = gameState_->tileHasBuilding(x, y);
+      bool hasTownhall = gameState_->getTownhallOwner(x, y) != NO_PLAYER;
+      Army* army = gameState_->getArmy(gameState_->findArmyByLocation(x, y));
+      if (!hasBuilding && !hasTownhall && !army) continue;
+      if (!gameState_->isVisible(player_, x, y)) continue;
+
+      int xPos = LEFT_MAP_OFFSET + x * (TILE_SIZE + OUTLINE_SIZE);
+      int yPos = TOP_MAP_OFFSET + y * (TILE_SIZE + OUTLINE_SIZE);
+      if (hasBuilding)
+        drawBuilding(*gameState_->findBuildingByLocation(x, y), xPos, yPos);
+      if (hasTownhall)
+        drawTownhall(gameState_->getTownhallByLocation(x, y), xPos, yPos);
+      if (army) drawArmy(*army, xPos, yPos);
+    }
   }
 
   displayArmyMovementRange();
+  window_->setView(window_->getDefaultView());
 }
 
 void UI::displayHighlightedtiles() {
-  for (auto tile : highlightedTiles_) {
-    drawTile(*tile, LEFT_MAP_OFFSET + tile->getX() * (TILE_SIZE + OUTLINE_SIZE),
-             TOP_MAP_OFFSET + tile->getY() * (TILE_SIZE + OUTLINE_SIZE),
+  for (const auto& [x, y] : highlightedTiles_) {
+    drawTile(gameState_->getTileType(x, y), gameState_->getTileOwner(x, y),
+             LEFT_MAP_OFFSET + x * (TILE_SIZE + OUTLINE_SIZE),
+             TOP_MAP_OFFSET + y * (TILE_SIZE + OUTLINE_SIZE),
              true  // sets it to be highlighted
     );
   }
@@ -253,28 +283,11 @@ void UI::displayMenu() {
 //
 // ==============
 
-void UI::drawTile(const Tile& tile, int xPos, int yPos, bool isHighlighted) {
+void UI::drawTile(TileType type, PlayerIndex owner, int xPos, int yPos,
+                  bool isHighlighted) {
   sf::RectangleShape rectangle(sf::Vector2f(38.f, 38.f));
   rectangle.setPosition(xPos, yPos);
-
-  if (tile.getOwner() != nullptr) {
-    rectangle.setFillColor(tile.getOwner()->getColor());
-  } else {
-    switch (tile.getType()) {
-      case GRASS:
-        rectangle.setFillColor(sf::Color(155, 255, 155));
-        break;
-      case WATER:
-        rectangle.setFillColor(sf::Color(45, 110, 210));
-        break;
-      case ROCK:
-        rectangle.setFillColor(sf::Color(210, 210, 210));
-        break;
-      default:
-        rectangle.setFillColor(sf::Color(155, 255, 155));
-        break;
-    }
-  }
+  rectangle.setFillColor(getTileColor(*gameState_, type, owner));
   rectangle.setOutlineThickness(1);
   rectangle.setOutlineColor(sf::Color(200, 200, 200));
 
@@ -337,17 +350,13 @@ void UI::drawTownhall(const TownHall& townhall, int xPos, int yPos) {
 }
 
 void UI::drawArmy(const Army& army, int xPos, int yPos) {
-  sf::Text text;
-
-  text.setFont(font);
-  text.setString(army.getName()[0] + std::to_string(army.getUnitCount()));
-
-  text.setCharacterSize(18);
-
-  text.setFillColor(army.getHasCompletedTurn() ? sf::Color::Black
-                                               : army.getOwner()->getColor());
-  text.setOutlineThickness(2);
-  text.setOutlineColor(sf::Color::White);
+  sf::Color color =
+      army.getHasCompletedTurn()
+          ? sf::Color::Black
+          : toSfColor(gameState_->getPlayer(army.getOwner())->getColor());
+  sf::Text& text = textCache_.get(
+      font, army.getName()[0] + std::to_string(army.getUnitCount()), 18, color,
+      2, sf::Color::White);
 
   sf::FloatRect bounds = text.getLocalBounds();
   float offsetX = (TILE_SIZE - bounds.width) / 2;
@@ -358,20 +367,19 @@ void UI::drawArmy(const Army& army, int xPos, int yPos) {
 }
 
 void UI::displayArmyMovementRange() {
-  if (selected_) {
-    Army* selectedArmy = dynamic_cast<Army*>(selected_);
-    if (selectedArmy) {
-      std::shared_ptr<Player> owner = selectedArmy->getOwner();
-      if (owner->getID() == gameState_->getActivePlayerID()) {
-        std::vector<std::pair<int, int>> movementRange =
-            gameState_->getArmyMovementRange(*selectedArmy);
-        auto it = movementRange.begin();
-        while (it != movementRange.end()) {
-          int xPos = LEFT_MAP_OFFSET + it->first * (TILE_SIZE + OUTLINE_SIZE);
-          int yPos = TOP_MAP_OFFSET + it->second * (TILE_SIZE + OUTLINE_SIZE);
-          drawArmyMovementSuggestionMarker(*selectedArmy, xPos, yPos);
-          it++;
-        }
+  Army* selectedArmy = gameState_->getArmy(selectedArmy_);
+  if (selectedArmy) {
+    const std::shared_ptr<Player>& owner =
+        gameState_->getPlayer(selectedArmy->getOwner());
+    if (owner->getID() == gameState_->getActivePlayerID()) {
+      std::vector<std::pair<int, int>> movementRange =
+          gameState_->getArmyMovementRange(*selectedArmy);
+      auto it = movementRange.begin();
+      while (it != movementRange.end()) {
+        int xPos = LEFT_MAP_OFFSET + it->first * (TILE_SIZE + OUTLINE_SIZE);
+        int yPos = TOP_MAP_OFFSET + it->second * (TILE_SIZE + OUTLINE_SIZE);
+        drawArmyMovementSuggestionMarker(*selectedArmy, xPos, yPos);
+        it++;
       }
     }
   }
@@ -395,8 +403,7 @@ void UI::drawArmyMovementSuggestionMarker(const Army& army, int xPos,
 // ==============
 
 void UI::addHighlightedTile(int xPos, int yPos) {
-  Tile& tile = gameState_->getTile(xPos, yPos);
-  highlightedTiles_.push_back(&tile);
+  highlightedTiles_.push_back(std::make_pair(xPos, yPos));
 }
 
 void UI::removeHighlightedTile(int xPos, int yPos) {
@@ -435,19 +442,29 @@ void UI::processMenuSelected(sf::Event event) {
     selected_ = selectedBuilding;
 
   } else if (activeMenu_ == ARMY) {
-    Army* army = dynamic_cast<Army*>(selected_);
+    Army* army = gameState_->getArmy(selectedArmy_);
+    if (army == nullptr) {
+      // the army was destroyed since it got selected
+      resetSelected();
+      activeMenu_ = Menu::BUILD;
+      return;
+    }
+    Action action;
+    action.x = army->getLocationX();
+    action.y = army->getLocationY();
     switch (menuItem) {
       case 0:
         std::cout << "Colonize selected" << std::endl;
-        gameState_->colonize(*army);
+        action.type = COLONIZE;
+        gameState_->execute(action);
         resetSelected();
         activeMenu_ = Menu::BUILD;
         break;
 
       case 1:
         std::cout << "Add unit selected" << std::endl;
-        gameState_->incrementArmyUnit(*army);
-        // To do: cost
+        action.type = INCREMENT_ARMY_UNIT;
+        gameState_->execute(action);
         break;
 
       case 2:
@@ -467,26 +484,26 @@ void UI::processMenuSelected(sf::Event event) {
       case 0:
         std::cout << "Add " << getArmyTypeName(INFANTRY) << " selected"
                   << std::endl;
-        gameState_->placeSoldiers(player_, INFANTRY);
+        placeSoldiers(INFANTRY);
         // activeMenu_ = Menu::BUILD;
         break;
 
       case 1:
         std::cout << "Add " << getArmyTypeName(CAVALRY) << " selected"
                   << std::endl;
-        gameState_->placeSoldiers(player_, CAVALRY);
+        placeSoldiers(CAVALRY);
         break;
 
       case 2:
         std::cout << "Add " << getArmyTypeName(ARTILLERY) << " selected"
                   << std::endl;
-        gameState_->placeSoldiers(player_, ARTILLERY);
+        placeSoldiers(ARTILLERY);
         break;
 
       case 3:
         std::cout << "Add " << getArmyTypeName(MARINE) << " selected"
                   << std::endl;
-        gameState_->placeSoldiers(player_, MARINE);
+        placeSoldiers(MARINE);
         break;
 
       default:
@@ -496,9 +513,7 @@ void UI::processMenuSelected(sf::Event event) {
 }
 
 void UI::processTileSelected(int xPos, int yPos) {
-  auto visibleXY = gameState_->getVisibleXY(player_);
-  if (std::find(visibleXY.begin(), visibleXY.end(),
-                std::make_pair(xPos, yPos)) == visibleXY.end()) {
+  if (!gameState_->isVisible(player_, xPos, yPos)) {
     std::cout << "Tile (" << xPos << ", " << yPos << ") is not visible"
               << std::endl;
     return;
@@ -514,18 +529,24 @@ void UI::processTileSelected(int xPos, int yPos) {
 
   BuildingBlueprint* selectedBuildingBlueprint =
       dynamic_cast<BuildingBlueprint*>(selected_);
-  Army* selectedArmy = dynamic_cast<Army*>(selected_);
+  Army* selectedArmy = gameState_->getArmy(selectedArmy_);
 
   if (selectedArmy) {
-    bool isOwn =
-        selectedArmy->getOwner()->getID() == gameState_->getActivePlayerID();
+    bool isOwn = gameState_->getPlayer(selectedArmy->getOwner())->getID() ==
+                 gameState_->getActivePlayerID();
     bool isActionable = isOwn && !selectedArmy->getHasCompletedTurn();
 
     if (isActionable) {
       bool isMovable =
           gameState_->isArmyWithinMovementRange(*selectedArmy, xPos, yPos);
       if (isMovable) {
-        gameState_->moveArmy(*selectedArmy, xPos, yPos);
+        Action action;
+        action.type = MOVE_ARMY;
+        action.x = selectedArmy->getLocationX();
+        action.y = selectedArmy->getLocationY();
+        action.toX = xPos;
+        action.toY = yPos;
+        gameState_->execute(action);
         resetSelected();
         activeMenu_ = Menu::BUILD;
         return;
@@ -542,16 +563,18 @@ void UI::processTileSelected(int xPos, int yPos) {
   }
 
   if (gameState_->tileHasArmy(xPos, yPos)) {
-    if (selectedBuildingBlueprint) delete (selected_);
-    Army& army = gameState_->getArmyByLocation(xPos, yPos);
-    selected_ = &army;
+    resetSelected();
+    selectedArmy_ = gameState_->findArmyByLocation(xPos, yPos);
+    Army& army = *gameState_->getArmy(selectedArmy_);
     if (!army.getHasCompletedTurn()) {
-      if (army.getOwner()->getID() == gameState_->getActivePlayerID())
+      if (gameState_->getPlayer(army.getOwner())->getID() ==
+          gameState_->getActivePlayerID())
         activeMenu_ = Menu::ARMY;
     }
   } else if (gameState_->tileHasTownhall(xPos, yPos)) {
     activeMenu_ = Menu::TOWNHALL;
     TownHall& Townhall = gameState_->getTownhallByLocation(xPos, yPos);
+    selectedArmy_ = ArmyHandle();
     selected_ = &Townhall;
   } else if (selectedBuildingBlueprint) {
     // check if user has enough resources to place a building
@@ -572,31 +595,30 @@ void UI::processTileSelected(int xPos, int yPos) {
 
     // check if tile is valid for building placement
     if (gameState_->canPlaceBuilding(xPos, yPos, player_->getID())) {
-      Building newBuilding = Building(
-          selectedBuildingBlueprint->getType(),
-          selectedBuildingBlueprint->getResourceCost(),
-          selectedBuildingBlueprint->getResourceGain(), player_, xPos, yPos);
-
-      gameState_->addBuilding(newBuilding);
+      // places the building and deducts its cost from the player
+      Action action;
+      action.type = ADD_BUILDING;
+      action.x = xPos;
+      action.y = yPos;
+      action.player = player_->getIndex();
+      action.unitType = selectedBuildingBlueprint->getType();
+      action.cost = selectedBuildingBlueprint->getResourceCost();
+      action.gain = selectedBuildingBlueprint->getResourceGain();
+      gameState_->execute(action);
 
       std::cout << "Building placed on tile (" << xPos << ", " << yPos << ")"
                 << std::endl;
 
-      // deduct resources from the player
-      Resources cost = selectedBuildingBlueprint->getResourceCost();
-      Resources negatedCost(-cost.food, -cost.wood, -cost.gold, -cost.stone);
-      player_->modifyResources(negatedCost);
-
       // cleanup and reset selection
       resetSelected();
       activeMenu_ = Menu::BUILD;
 
     } else {
       // if the tile is invalid, provides feedback
-      Tile& tile = gameState_->getTile(xPos, yPos);
+      const std::shared_ptr<Player>& owner =
+          gameState_->getPlayer(gameState_->getTileOwner(xPos, yPos));
 
-      if (tile.getOwner() == nullptr ||
-          tile.getOwner()->getID() != player_->getID()) {
+      if (owner == nullptr || owner->getID() != player_->getID()) {
         std::cout << "Can't put building: Tile (" << xPos << ", " << yPos
                   << ") is not owned by you." << std::endl;
       } else if (gameState_->tileHasBuilding(xPos, yPos)) {
@@ -613,9 +635,24 @@ void UI::processTileSelected(int xPos, int yPos) {
   }
 }
 
-Selectable* UI::getSelected() const { return selected_; }
+Selectable* UI::getSelected() const {
+  Army* selectedArmy = gameState_->getArmy(selectedArmy_);
+  if (selectedArmy) return selectedArmy;
+  return selected_;
+}
 
-void UI::setSelected(Selectable* selectable) { selected_ = selectable; }
+void UI::setSelected(Selectable* selectable) {
+  selectedArmy_ = ArmyHandle();
+  selected_ = selectable;
+}
+
+void UI::placeSoldiers(ArmyType armyType) {
+  Action action;
+  action.type = PLACE_SOLDIERS;
+  action.player = player_->getIndex();
+  action.unitType = armyType;
+  gameState_->execute(action);
+}
 
 void UI::resetSelected() {
   BuildingBlueprint* selectedBuildingBlueprint =
@@ -626,4 +663,5 @@ void UI::resetSelected() {
   if (selectedBuildingBlueprint) delete selected_;
 
   selected_ = nullptr;
+  selectedArmy_ = ArmyHandle();
 }
\ No newline at end of file
@@ -1,12 +1,16 @@
 #ifndef SRC_UI_HPP_
 #define SRC_UI_HPP_
 
+#include <array>
 #include <iostream>
 #include <sstream>
 
 #include "building.hpp"
+#include "camera.hpp"
 #include "gamestate.hpp"
+#include "maprenderer.hpp"
 #include "selectable.hpp"
+#include "textcache.hpp"
 #include "uimanager.hpp"
 #include "utils.hpp"
 
@@ -41,6 +45,23 @@ class UI {
    */
   void processMouseButtonPressed(sf::Event event);
 
+  /**
+   * @brief Processes the KeyPressed event in the players UI: Ctrl+Z undoes
+   * the last action of the turn, Ctrl+Y or Ctrl+Shift+Z redoes it. The arrow
+   * keys pan the map, + and - zoom it and Home resets the camera.
+   *
+   * @param event
+   */
+  void processKeyPressed(sf::Event event);
+
+  /**
+   * @brief Processes the MouseWheelScrolled event in the players UI, zooming
+   * the map around the mouse.
+   *
+   * @param event
+   */
+  void processMouseWheelScrolled(sf::Event event);
+
  private:
   // UI ELEMENTS
 
@@ -62,7 +83,7 @@ class UI {
 
   // GAME PIECES
 
-  void drawTile(const Tile& tile, int xPos, int yPos,
+  void drawTile(TileType type, PlayerIndex owner, int xPos, int yPos,
                 bool isHighlighted = false);
 
   void drawBuilding(const Building& building, int xPos, int yPos);
@@ -85,6 +106,8 @@ class UI {
 
   void processTileSelected(int xPos, int yPos);
 
+  void placeSoldiers(ArmyType armyType);
+
   Selectable* getSelected() const;
 
   void setSelected(Selectable* selectable);
@@ -96,15 +119,26 @@ class UI {
   std::shared_ptr<sf::RenderWindow> window_;
   std::shared_ptr<Player> player_;
   std::shared_ptr<GameState> gameState_;
+  // Terrain and ownership of the visible tiles
+  MapRenderer mapRenderer_;
+  // Part of the map shown
+  Camera camera_;
 
   Menu activeMenu_;
   // selected_;
-  std::vector<Tile*> highlightedTiles_;
+  std::vector<std::pair<int, int>> highlightedTiles_;
 
   Selectable* selected_ = nullptr;
+  // Armies move around in GameState's storage, so they are selected by handle
+  ArmyHandle selectedArmy_;
 
   // UI constants
   sf::Font font;
+  // Labels drawn every frame, laid out again only when they change
+  TextCache textCache_;
+  // Resource amounts and incomes the resource labels were formatted from
+  std::array<int, 8> shownAmounts_{};
+  std::array<std::string, 4> resourceLabels_;
 };
 
 #endif  // SRC_UI_HPP_
@@ -1,14 +1,15 @@
 #include "mapeditor.hpp"
 
-std::string readFileToStringMapEd(const std::string& filename);
-void loadMapFromString(const std::string str, int num_rows);
-
 MapEditor::MapEditor(UIManager& uiManager, sf::Font font,
-                     std::shared_ptr<sf::RenderWindow> window)
+                     std::shared_ptr<sf::RenderWindow> window,
+                     const std::string& filename)
     : uiManager_(uiManager), font_(font), window_(window) {
-  std::string filename = "maps/grey.txt";
-  std::string fileContent = readFileToStringMapEd(filename);
-  loadMapFromString(fileContent, NUM_OF_ROWS);
+  try {
+    MapFile map = MapFile::load(filename);
+    loadMapFromString(map.getTiles(), map.getNumRows());
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+  }
 }
 
 /////////////////
@@ -19,23 +20,7 @@ void MapEditor::drawTile(const Tile& tile, int xPos, int yPos,
                          bool isHighlighted) {
   sf::RectangleShape rectangle(sf::Vector2f(38.f, 38.f));
   rectangle.setPosition(xPos, yPos);
-  switch (tile.getType()) {
-    case GRASS:
-      rectangle.setFillColor(sf::Color(155, 255, 155));
-      break;
-    case WATER:
-      rectangle.setFillColor(sf::Color(45, 110, 210));
-      break;
-    case ROCK:
-      rectangle.setFillColor(sf::Color(210, 210, 210));
-      break;
-    case PLACEHOLDER:
-      rectangle.setFillColor(sf::Color(128, 128, 128));
-      break;
-    default:
-      rectangle.setFillColor(sf::Color(155, 255, 155));
-      break;
-  }
+  rectangle.setFillColor(getTerrainColor(tile.getType()));
 
   rectangle.setOutlineThickness(1);
   rectangle.setOutlineColor(sf::Color(200, 200, 200));
@@ -60,13 +45,14 @@ void MapEditor::displayUI() {
 }
 
 void MapEditor::displayMap() {
-  for (auto tile : placeHolderMap) {
-    // tile is of size 38 and 2*1mm outline on each side
-    drawTile(tile, LEFT_MAP_OFFSET + tile.getX() * (TILE_SIZE + OUTLINE_SIZE),
-             TOP_MAP_OFFSET + tile.getY() * (TILE_SIZE + OUTLINE_SIZE));
-  }
+  // tile is of size 38 and 2*1mm outline on each side, drawn through the
+  // camera at the position it has when the map is neither panned nor zoomed
+  window_->setView(camera_.getView());
+  layer_.draw(*window_, sf::Vector2f(LEFT_MAP_OFFSET, TOP_MAP_OFFSET),
+              camera_.getVisibleTiles());
 
   displayHighlightedtiles();
+  window_->setView(window_->getDefaultView());
 }
 
 void MapEditor::displaySave() {
@@ -156,6 +142,7 @@ void MapEditor::processMenuSelected(sf::Event event) {
 
 void MapEditor::processTileSelected(int xPos, int yPos) {
   getTile(xPos, yPos).setType(selectedType_);
+  layer_.setTile(xPos, yPos, getTerrainColor(selectedType_));
   if (!highlightedTiles_.empty())
     highlightedTiles_.pop_back();  // ghetto implementation to remove the
                                    // highlight of a previously selected tile
@@ -166,11 +153,10 @@ void MapEditor::processMouseButtonPressed(sf::Event event) {
   if (endTurnArea.contains(event.mouseButton.x, event.mouseButton.y)) {
     saveMapToFile("maps/saved_map.txt");
   }
-  if (mapArea.contains(event.mouseButton.x, event.mouseButton.y)) {
-    int xPos =
-        (event.mouseButton.x - LEFT_MAP_OFFSET) / (TILE_SIZE + OUTLINE_SIZE);
-    int yPos =
-        (event.mouseButton.y - TOP_MAP_OFFSET) / (TILE_SIZE + OUTLINE_SIZE);
+  int xPos, yPos;
+  if (camera_.getTileAt(
+          *window_, sf::Vector2i(event.mouseButton.x, event.mouseButton.y),
+          xPos, yPos)) {
     processTileSelected(xPos, yPos);
   }
   if (menuArea.contains(event.mouseButton.x, event.mouseButton.y)) {
@@ -178,43 +164,45 @@ void MapEditor::processMouseButtonPressed(sf::Event event) {
   }
 }
 
+void MapEditor::processKeyPressed(sf::Event event) {
+  camera_.processEvent(event, *window_);
+}
+
+void MapEditor::processMouseWheelScrolled(sf::Event event) {
+  camera_.processEvent(event, *window_);
+}
+
 /////////////////
 /////HELPERS/////
 /////////////////
 
 // Works but saves map into build/maps/....
 void MapEditor::saveMapToFile(const std::string& filename) const {
-  std::ofstream file(filename);
-
-  if (!file.is_open()) {
-    std::cerr << "Could not open the file for writing: " << filename
-              << std::endl;
-    return;
-  }
-
-  for (int i = 0; i < NUM_OF_ROWS * NUM_OF_COLS; i++) {
-    const Tile& tile = placeHolderMap[i];
+  std::string tiles;
+  for (const Tile& tile : placeHolderMap) {
     switch (tile.getType()) {
       case GRASS:
-        file << 'G';
+        tiles += 'G';
         break;
       case WATER:
-        file << 'W';
+        tiles += 'W';
         break;
       case ROCK:
-        file << 'R';
+        tiles += 'R';
         break;
       case PLACEHOLDER:
       default:
-        file << 'N';
+        tiles += 'N';
         break;
     }
-    if (i > 0 && ((i + 1) % NUM_OF_ROWS == 0)) {
-      file << '\n';  // Move to the next row
-    }
   }
 
-  file.close();
+  try {
+    MapFile(num_cols_, num_rows_, tiles).save(filename);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return;
+  }
   std::cout << "Map saved to " << filename << std::endl;
 }
 
@@ -224,13 +212,13 @@ void MapEditor::addHighlightedTile(int xPos, int yPos) {
 }
 
 bool MapEditor::areCoordinatesValid(int x, int y) const {
-  int idx = x * NUM_OF_ROWS + y;
-  return idx >= 0 && idx < placeHolderMap.size() && y < NUM_OF_ROWS && x >= 0 &&
+  int idx = x * num_rows_ + y;
+  return idx >= 0 && idx < placeHolderMap.size() && y < num_rows_ && x >= 0 &&
          y >= 0;
 }
 
 Tile& MapEditor::getTile(int xPos, int yPos) {
-  int idx = xPos * NUM_OF_ROWS + yPos;
+  int idx = xPos * num_rows_ + yPos;
 
   if (areCoordinatesValid(xPos, yPos)) {
     return placeHolderMap[idx];
@@ -240,6 +228,10 @@ Tile& MapEditor::getTile(int xPos, int yPos) {
 }
 
 void MapEditor::loadMapFromString(const std::string str, int num_rows) {
+  num_rows_ = num_rows;
+  num_cols_ = num_rows > 0 ? str.size() / num_rows : 0;
+  placeHolderMap.clear();
+  highlightedTiles_.clear();
   for (int i = 0; i < str.size(); i++) {
     switch (str[i]) {
       case 'G':
@@ -259,22 +251,12 @@ void MapEditor::loadMapFromString(const std::string str, int num_rows) {
         break;
     }
   }
-}
-
-std::string readFileToStringMapEd(const std::string& filename) {
-  std::ifstream file(filename);
-  std::string line;
-  std::string content;
 
-  if (!file.is_open()) {
-    std::cerr << "Could not open the file: " << filename << std::endl;
-    return "";
+  if (!layer_.reset(num_cols_, num_rows_))
+    std::cerr << "The map is too large to be drawn" << std::endl;
+  camera_.setMapSize(num_cols_, num_rows_);
+  camera_.reset();
+  for (const Tile& tile : placeHolderMap) {
+    layer_.setTile(tile.getX(), tile.getY(), getTerrainColor(tile.getType()));
   }
-  // Read each line from the file and append it to the content string
-  while (std::getline(file, line)) {
-    content += line;
-  }
-
-  file.close();
-  return content;
-}
\ No newline at end of file
+}
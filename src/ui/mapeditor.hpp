@@ -7,7 +7,10 @@
 #include <memory>
 #include <string>
 
+#include "../camera.hpp"
+#include "../mapfile.hpp"
 #include "../tile.hpp"
+#include "../tilelayer.hpp"
 #include "../uimanager.hpp"
 #include "../utils.hpp"
 
@@ -19,9 +22,11 @@ class MapEditor {
    * @param window
    * @param font
    * @param uiManager
+   * @param filename map file to start editing from
    */
   MapEditor(UIManager& uiManager, sf::Font font,
-            std::shared_ptr<sf::RenderWindow> window);
+            std::shared_ptr<sf::RenderWindow> window,
+            const std::string& filename = "maps/grey.txt");
 
   /**
    * @brief Displays (draws) the mapeditor UI on the render window.
@@ -87,8 +92,8 @@ class MapEditor {
   bool areCoordinatesValid(int x, int y) const;
 
   /**
-   * @brief Saves the map in its current state to a file named "saved_map.txt"
-   * into build/maps.
+   * @brief Saves the map in its current state, with a header carrying its
+   * size, to a file named "saved_map.txt" into build/maps.
    * @param filename custom filenam for saving
    */
   void saveMapToFile(const std::string& filename) const;
@@ -116,6 +121,22 @@ class MapEditor {
    */
   void processMouseButtonPressed(sf::Event event);
 
+  /**
+   * @brief Processes the KeyPressed event in the mapeditor UI, the camera
+   * controls pan and zoom the map.
+   *
+   * @param event
+   */
+  void processKeyPressed(sf::Event event);
+
+  /**
+   * @brief Processes the MouseWheelScrolled event in the mapeditor UI,
+   * zooming the map around the mouse.
+   *
+   * @param event
+   */
+  void processMouseWheelScrolled(sf::Event event);
+
   /**
    * @brief Loads the map, (populates the placeHolderMap) from a file.
    *
@@ -129,9 +150,14 @@ class MapEditor {
   UIManager& uiManager_;
   sf::Font font_;
 
-  int num_rows_;
+  int num_cols_ = 0;
+  int num_rows_ = 0;
   TileType selectedType_;
   std::vector<Tile> placeHolderMap;
+  // Colors of placeHolderMap, updated tile by tile as the map is edited
+  TileLayer layer_;
+  // Part of the map shown
+  Camera camera_;
   std::vector<Tile> highlightedTiles_;
 };
 
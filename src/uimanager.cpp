@@ -1,5 +1,7 @@
 #include "uimanager.hpp"
 
+#include <algorithm>
+
 // CONSTANTS
 
 // COLORS
@@ -11,9 +13,6 @@ sf::Color LIGHT_GRAY = sf::Color(180, 180, 180);
 
 // UI AREAS
 sf::IntRect endTurnArea(1080, 863, 200, 160);
-sf::IntRect mapArea(LEFT_MAP_OFFSET, TOP_MAP_OFFSET,
-                    NUM_OF_COLS*(TILE_SIZE + OUTLINE_SIZE),
-                    NUM_OF_ROWS*(TILE_SIZE + OUTLINE_SIZE));
 sf::IntRect menuArea(LEFT_MAP_OFFSET, 863, WINDOW_WIDTH - LEFT_MAP_OFFSET - 200,
                      160);
 // For mainmenu:
@@ -22,6 +21,14 @@ sf::IntRect startArea(WINDOW_WIDTH / 2 - 250 / 2,
 sf::IntRect mapeditorArea(WINDOW_WIDTH / 2 - 250 / 2,
                           WINDOW_HEIGHT / 2 - 100 / 2 + 50, 250, 100);
 
+sf::IntRect getMapArea(int numCols, int numRows) {
+  int width = std::min<int>(numCols * (TILE_SIZE + OUTLINE_SIZE),
+                            WINDOW_WIDTH - LEFT_MAP_OFFSET);
+  int height = std::min<int>(numRows * (TILE_SIZE + OUTLINE_SIZE),
+                             menuArea.top - TOP_MAP_OFFSET);
+  return sf::IntRect(LEFT_MAP_OFFSET, TOP_MAP_OFFSET, width, height);
+}
+
 UIManager::UIManager() {
   // Default to main menu
   setState(MAINMENU);
@@ -12,10 +12,6 @@ enum UIState { MAINMENU, GAME, MAPEDITOR, VICTORY };
 constexpr const int WINDOW_WIDTH = 1280;
 constexpr const int WINDOW_HEIGHT = 1024;
 
-// MAP SPECIFIC VALUES
-constexpr const int NUM_OF_COLS = 25;
-constexpr const int NUM_OF_ROWS = 20;
-
 // UI OFFSETS
 constexpr const int TOP_MAP_OFFSET = 64;
 constexpr const int LEFT_MAP_OFFSET = 280;
@@ -23,6 +19,12 @@ constexpr const int LEFT_MAP_OFFSET = 280;
 constexpr const float TILE_SIZE = 38;
 constexpr const float OUTLINE_SIZE = 2;
 
+// CAMERA
+// Pixels the map moves by per arrow key press
+constexpr const float CAMERA_PAN_STEP = 160;
+// Factor the zoom changes by per key press or mouse wheel step
+constexpr const float CAMERA_ZOOM_STEP = 1.25f;
+
 // COLORS
 extern sf::Color UI_BG;
 
@@ -32,12 +34,22 @@ extern sf::Color LIGHT_GRAY;
 
 // UI AREAS
 extern sf::IntRect endTurnArea;
-extern sf::IntRect mapArea;
 extern sf::IntRect menuArea;
 // For mainmenu:
 extern sf::IntRect startArea;
 extern sf::IntRect mapeditorArea;
 
+/**
+ * @brief Get the area of the window a map is drawn in
+ *
+ * The area grows with the map, up to the edges of the menus.
+ *
+ * @param numCols
+ * @param numRows
+ * @return sf::IntRect
+ */
+sf::IntRect getMapArea(int numCols, int numRows);
+
 class UIManager {
  public:
   /**
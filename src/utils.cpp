@@ -3,6 +3,10 @@
 
 #include <iostream>
 
+sf::Color toSfColor(const Color& color) {
+  return sf::Color(color.r, color.g, color.b, color.a);
+}
+
 sf::RectangleShape createRect(float x, float y, float width, float height,
                               sf::Color fillColor) {
   sf::RectangleShape rectangle(sf::Vector2f(width, height));
@@ -42,7 +46,13 @@ sf::Text createTextForRect(sf::RectangleShape rect, sf::Font& font,
   t.setString(text);
   t.setFillColor(fillColor);
   t.setCharacterSize(charSize);
+  alignTextInRect(t, rect, orientationX, orientationY);
 
+  return t;
+}
+
+void alignTextInRect(sf::Text& t, const sf::RectangleShape& rect,
+                     ORIENTATION orientationX, ORIENTATION orientationY) {
   // Get the text's bounds after setting the string
   sf::FloatRect textBounds = t.getLocalBounds();
   // Get rectangle properties
@@ -77,8 +87,6 @@ sf::Text createTextForRect(sf::RectangleShape rect, sf::Font& font,
 
   t.setOrigin(originX, originY);
   t.setPosition(posX, posY);
-
-  return t;
 }
 
 std::vector<sf::Text> createTextsForRect(sf::RectangleShape rect,
@@ -4,10 +4,20 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 
+#include "color.hpp"
+
 // A file with common utility functions used across all classes.
 
 enum ORIENTATION { START, CENTER, END };
 
+/**
+ * @brief Convert a player Color to an SFML color
+ *
+ * @param color
+ * @return sf::Color
+ */
+sf::Color toSfColor(const Color& color);
+
 /**
  * @brief Create a Rect object
  *
@@ -87,6 +97,21 @@ sf::Text createTextForRect(sf::RectangleShape rect, sf::Font& font,
                            ORIENTATION orientationX = CENTER,
                            ORIENTATION orientationY = CENTER);
 
+/**
+ * @brief Position a Text inside a Rect object
+ *
+ * Places the text like createTextForRect does, for texts that are kept
+ * around instead of being created every frame.
+ *
+ * @param t
+ * @param rect
+ * @param orientationX
+ * @param orientationY
+ */
+void alignTextInRect(sf::Text& t, const sf::RectangleShape& rect,
+                     ORIENTATION orientationX = CENTER,
+                     ORIENTATION orientationY = CENTER);
+
 /**
  * @brief Create a vector of text inside a Rect object
  *
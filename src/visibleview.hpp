@@ -0,0 +1,176 @@
+#ifndef SRC_VISIBLEVIEW_HPP_
+#define SRC_VISIBLEVIEW_HPP_
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "fogofwar.hpp"
+
+/**
+ * @brief Non-owning range over the elements of a GameState container that a
+ * player can see.
+ *
+ * Iterating the view neither allocates nor copies; it walks the live container
+ * and skips the elements standing on hidden tiles. T has to provide getXY().
+ * Like any iterator into a std::vector, a view is invalidated by mutating the
+ * GameState it was taken from.
+ *
+ * @tparam T Building, TownHall or Army
+ */
+template <typename T>
+class VisibleView {
+ public:
+  using Container = std::vector<T>;
+
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    Iterator(const VisibleView* view, typename Container::const_iterator it)
+        : view_(view), it_(it) {
+      skipHidden();
+    }
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &*it_; }
+
+    Iterator& operator++() {
+      ++it_;
+      skipHidden();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++(*this);
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const { return it_ == other.it_; }
+    bool operator!=(const Iterator& other) const { return it_ != other.it_; }
+
+   private:
+    void skipHidden() {
+      while (it_ != view_->items_->end() && !view_->isVisible(*it_)) ++it_;
+    }
+
+    const VisibleView* view_;
+    typename Container::const_iterator it_;
+  };
+
+  /**
+   * @brief Construct a new VisibleView
+   *
+   * @param items container to filter
+   * @param fog fog of war to filter by
+   * @param playerIndex player whose visibility is used
+   * @param numRows number of map rows, used to compute tile indices
+   */
+  VisibleView(const Container& items, const FogOfWar& fog, int playerIndex,
+              int numRows)
+      : items_(&items), fog_(&fog), playerIndex_(playerIndex),
+        numRows_(numRows) {}
+
+  Iterator begin() const { return Iterator(this, items_->begin()); }
+  Iterator end() const { return Iterator(this, items_->end()); }
+
+  /**
+   * @brief Checks if the view has no visible element
+   *
+   * @return true
+   * @return false
+   */
+  bool empty() const { return begin() == end(); }
+
+ private:
+  bool isVisible(const T& item) const {
+    auto [x, y] = item.getXY();
+    return y >= 0 && y < numRows_ &&
+           fog_->isVisible(playerIndex_, x * numRows_ + y);
+  }
+
+  const Container* items_;
+  const FogOfWar* fog_;
+  int playerIndex_;
+  int numRows_;
+};
+
+/**
+ * @brief Non-owning range over the coordinates of the map tiles that a player
+ * can see.
+ *
+ * Tiles are not stored as objects, so the view yields (x, y) pairs which can
+ * be used with the GameState tile accessors. Iterating walks the visibility
+ * bitmap directly and skips hidden tiles without touching them.
+ */
+class VisibleTileView {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<int, int>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::pair<int, int>*;
+    using reference = std::pair<int, int>;
+
+    Iterator(const VisibleTileView* view, int index)
+        : view_(view), index_(index) {}
+
+    reference operator*() const {
+      return std::make_pair(index_ / view_->numRows_, index_ % view_->numRows_);
+    }
+
+    Iterator& operator++() {
+      index_ = view_->fog_->findNextVisible(view_->playerIndex_, index_ + 1);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++(*this);
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const VisibleTileView* view_;
+    int index_;
+  };
+
+  /**
+   * @brief Construct a new VisibleTileView
+   *
+   * @param fog fog of war to filter by
+   * @param playerIndex player whose visibility is used
+   * @param numTiles number of map tiles
+   * @param numRows number of map rows, used to compute tile coordinates
+   */
+  VisibleTileView(const FogOfWar& fog, int playerIndex, int numTiles,
+                  int numRows)
+      : fog_(&fog), playerIndex_(playerIndex), numTiles_(numTiles),
+        numRows_(numRows) {}
+
+  Iterator begin() const {
+    return Iterator(this, fog_->findNextVisible(playerIndex_, 0));
+  }
+  Iterator end() const { return Iterator(this, numTiles_); }
+
+ private:
+  const FogOfWar* fog_;
+  int playerIndex_;
+  int numTiles_;
+  int numRows_;
+};
+
+#endif  // SRC_VISIBLEVIEW_HPP_
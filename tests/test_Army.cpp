@@ -4,9 +4,7 @@
 #include "army.hpp"
 
 void testArmyConstructor() {
-    Resources initialResources(0, 0, 0, 0);
-    std::shared_ptr<Player> owner =
-        std::make_shared<Player>(sf::Color::Red, 1, initialResources);
+    PlayerIndex owner = 0;
 
     ArmyType type = INFANTRY;
     int x = 2;
@@ -23,9 +21,7 @@ void testArmyConstructor() {
 }
 
 void testUnitCount() {
-    Resources initialResources(0, 0, 0, 0);
-    std::shared_ptr<Player> owner =
-        std::make_shared<Player>(sf::Color::Red, 1, initialResources);
+    PlayerIndex owner = 0;
 
     ArmyType type = INFANTRY;
     int x = 2;
@@ -44,9 +40,7 @@ void testUnitCount() {
 }
 
 void testCanAdvance() {
-    Resources initialResources(0, 0, 0, 0);
-    std::shared_ptr<Player> owner =
-        std::make_shared<Player>(sf::Color::Red, 1, initialResources);
+    PlayerIndex owner = 0;
 
     int x = 2;
     int y = 3;
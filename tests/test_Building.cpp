@@ -5,7 +5,7 @@
 #include "player.hpp"
 
 void testBuildingConstructor() {
-    auto owner = std::make_shared<Player>(sf::Color::Red, 1);
+    PlayerIndex owner = 0;
 
     Building building(WOOD_CUTTER, {}, {}, owner, 10, 15);
 
@@ -19,8 +19,8 @@ void testBuildingConstructor() {
 }
 
 void testBuildingSetOwner() {
-    auto owner1 = std::make_shared<Player>(sf::Color::Blue, 1);
-    auto owner2 = std::make_shared<Player>(sf::Color::Green, 2);
+    PlayerIndex owner1 = 0;
+    PlayerIndex owner2 = 1;
 
     Building building(WOOD_CUTTER, {}, {}, owner1, 10, 15);
     auto previousOwner = building.setOwner(owner2);
@@ -32,7 +32,7 @@ void testBuildingSetOwner() {
 }
 
 void testBuildingNextTurn() {
-    auto owner = std::make_shared<Player>(sf::Color::Red, 1);
+    PlayerIndex owner = 0;
 
     Building building(WOOD_CUTTER, {}, {}, owner, 10, 15);
     auto nextTurnResources = building.nextTurn();
@@ -0,0 +1,326 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "commandlog.hpp"
+#include "gamestate.hpp"
+#include "replay.hpp"
+#include "testutils.hpp"
+
+void testCommandLogCursor() {
+    CommandLog log;
+    assert(!log.canUndo() && !log.canRedo());
+    assert(log.undo() == nullptr);
+
+    Action first;
+    first.type = COLONIZE;
+    Action second;
+    second.type = INCREMENT_ARMY_UNIT;
+    log.push(Command(first));
+    log.push(Command(second));
+
+    assert(log.undo()->action.type == INCREMENT_ARMY_UNIT);
+    assert(log.undo()->action.type == COLONIZE);
+    assert(log.undo() == nullptr);
+    assert(log.redo()->action.type == COLONIZE);
+    assert(log.canRedo());
+
+    // A new command drops the one that could have been redone
+    log.push(Command(second));
+    assert(!log.canRedo());
+    assert(log.undo()->action.type == INCREMENT_ARMY_UNIT);
+    assert(log.undo()->action.type == COLONIZE);
+
+    log.clear();
+    assert(!log.canUndo() && !log.canRedo());
+    std::cout << "testCommandLogCursor passed." << std::endl;
+}
+
+struct Game {
+    std::shared_ptr<GameState> gs = std::make_shared<GameState>();
+    std::shared_ptr<Player> p1 = std::make_shared<Player>(Color::Red, 1);
+    std::shared_ptr<Player> p2 = std::make_shared<Player>(Color::Blue, 2);
+
+    // 6 x 6 grass map, each player with some land and, unless left out, a
+    // townhall
+    explicit Game(bool p1Townhall = true, bool p2Townhall = true) {
+        gs->addPlayer(p1);
+        gs->addPlayer(p2);
+        gs->loadMapFromString(std::string(36, 'G'), 6);
+        gs->claimTile(0, 0, p1);
+        gs->claimTile(0, 1, p1);
+        gs->claimTile(5, 5, p2);
+        gs->claimTile(5, 4, p2);
+        if (p1Townhall) gs->addTownhall(TownHall(1, 1, p1->getIndex(), 0, 0));
+        if (p2Townhall) gs->addTownhall(TownHall(2, 1, p2->getIndex(), 5, 5));
+        gs->addBuilding(Building(FARM, Resources(0, 0, 0, 0),
+                                 Resources(5, 0, 0, 0), p2->getIndex(), 5, 4));
+        gs->setActivePlayerID(p1->getID());
+    }
+};
+
+Action makeAction(ActionType type, int x, int y, int toX = 0, int toY = 0) {
+    Action action;
+    action.type = type;
+    action.x = x;
+    action.y = y;
+    action.toX = toX;
+    action.toY = toY;
+    return action;
+}
+
+void testUndoMove() {
+    Game game;
+    game.gs->addArmy(CAVALRY, 1, 1, game.p1->getIndex(), 3);
+    std::string before = describe(*game.gs);
+    SnapshotWriter beforeSnapshot;
+    game.gs->writeSnapshot(beforeSnapshot);
+
+    game.gs->execute(makeAction(MOVE_ARMY, 1, 1, 1, 3));
+    assert(game.gs->tileHasArmy(1, 3));
+    std::string after = describe(*game.gs);
+
+    assert(game.gs->undo());
+    assert(!game.gs->canUndo() && game.gs->canRedo());
+    assert(describe(*game.gs) == before);
+    SnapshotWriter undone;
+    game.gs->writeSnapshot(undone);
+    assert(undone.getData() == beforeSnapshot.getData());
+
+    assert(game.gs->redo());
+    assert(describe(*game.gs) == after);
+    assert(!game.gs->redo());
+    std::cout << "testUndoMove passed." << std::endl;
+}
+
+void testUndoCombat() {
+    Game game;
+    game.gs->addArmy(ARTILLERY, 3, 3, game.p1->getIndex(), 20);
+    game.gs->addArmy(INFANTRY, 3, 4, game.p2->getIndex(), 1);
+    ArmyHandle enemy = game.gs->findArmyByLocation(3, 4);
+    std::string before = describe(*game.gs);
+
+    // The enemy army is wiped out and the attacker takes its tile
+    game.gs->execute(makeAction(MOVE_ARMY, 3, 3, 3, 4));
+    assert(game.gs->getArmy(enemy) == nullptr);
+    assert(game.gs->getArmyByLocation(3, 4).getOwner() ==
+           game.p1->getIndex());
+
+    assert(game.gs->undo());
+    assert(describe(*game.gs) == before);
+    // Handles of erased armies are valid again
+    assert(game.gs->getArmy(enemy) != nullptr);
+    assert(game.gs->getArmy(enemy)->getUnitCount() == 1);
+    assert(game.gs->findArmyByLocation(3, 4) == enemy);
+    std::cout << "testUndoCombat passed." << std::endl;
+}
+
+void testUndoEconomy() {
+    Game game;
+    game.p1->modifyResources(Resources(500, 500, 500, 500));
+    game.gs->addArmy(INFANTRY, 5, 4, game.p1->getIndex(), 2);
+    std::string before = describe(*game.gs);
+    int wood = game.p1->getResources().wood;
+
+    Action build = makeAction(ADD_BUILDING, 0, 1);
+    build.player = game.p1->getIndex();
+    build.unitType = MINE;
+    build.cost = Resources(0, 30, 10, 0);
+    build.gain = Resources(0, 0, 10, 10);
+    game.gs->execute(build);
+    Action recruit;
+    recruit.type = PLACE_SOLDIERS;
+    recruit.player = game.p1->getIndex();
+    recruit.unitType = INFANTRY;
+    game.gs->execute(recruit);
+    game.gs->execute(makeAction(INCREMENT_ARMY_UNIT, 5, 4));
+    // Colonizing an enemy tile frees it and destroys the farm on it
+    game.gs->execute(makeAction(COLONIZE, 5, 4));
+
+    assert(game.gs->tileHasBuilding(0, 1));
+    assert(!game.gs->tileHasBuilding(5, 4));
+    assert(game.gs->getTileOwner(5, 4) == NO_PLAYER);
+    assert(game.p1->getResources().wood < wood);
+    assert(game.gs->getIncome(game.p2).food == 0);
+
+    while (game.gs->undo()) {
+    }
+    assert(describe(*game.gs) == before);
+    assert(game.gs->tileHasBuilding(5, 4));
+    std::cout << "testUndoEconomy passed." << std::endl;
+}
+
+void testUndoClampedCharge() {
+    Game game;
+    Resources start = game.p1->getResources();
+
+    // The building costs more wood than the player has, the charge stops at 0
+    Action build = makeAction(ADD_BUILDING, 0, 1);
+    build.player = game.p1->getIndex();
+    build.unitType = WOOD_CUTTER;
+    build.cost = Resources(0, start.wood + 50, 0, 0);
+    game.gs->execute(build);
+    assert(game.p1->getResources().wood == 0);
+
+    assert(game.gs->undo());
+    assert(game.p1->getResources().wood == start.wood);
+    std::cout << "testUndoClampedCharge passed." << std::endl;
+}
+
+void testUndoGameover() {
+    Game game;
+    game.gs->addArmy(INFANTRY, 5, 5, game.p1->getIndex(), 1);
+    game.gs->addArmy(CAVALRY, 2, 2, game.p2->getIndex(), 4);
+    std::string before = describe(*game.gs);
+
+    // Taking the townhall knocks the owner out of the game
+    game.gs->execute(makeAction(COLONIZE, 5, 5));
+    assert(!game.p2->getIsAlive());
+    assert(!game.gs->tileHasArmy(2, 2));
+    assert(game.gs->getWinner() == game.p1);
+
+    assert(game.gs->undo());
+    assert(game.p2->getIsAlive());
+    assert(describe(*game.gs) == before);
+    assert(game.gs->getWinner() == nullptr);
+    std::cout << "testUndoGameover passed." << std::endl;
+}
+
+void testUndoGameoverAttackerMoved() {
+    Game game;
+    // The attacker comes last in the army storage, so erasing the loser's
+    // armies moves it to another slot
+    game.gs->addArmy(CAVALRY, 2, 2, game.p2->getIndex(), 4);
+    game.gs->addArmy(INFANTRY, 3, 2, game.p2->getIndex(), 2);
+    game.gs->addArmy(INFANTRY, 1, 3, game.p1->getIndex(), 3);
+    game.gs->addArmy(INFANTRY, 5, 5, game.p1->getIndex(), 1);
+    ArmyHandle attacker = game.gs->findArmyByLocation(5, 5);
+    std::string before = describe(*game.gs);
+
+    game.gs->execute(makeAction(COLONIZE, 5, 5));
+    assert(!game.p2->getIsAlive());
+    assert(game.gs->getArmy(attacker)->getHasCompletedTurn());
+    assert(game.gs->getArmy(attacker)->getLocationX() == 5);
+    assert(!game.gs->getArmyByLocation(1, 3).getHasCompletedTurn());
+
+    assert(game.gs->undo());
+    assert(describe(*game.gs) == before);
+    assert(!game.gs->getArmy(attacker)->getHasCompletedTurn());
+    std::cout << "testUndoGameoverAttackerMoved passed." << std::endl;
+}
+
+// Runs an action that does not fit the game and checks that it left no trace
+void assertRejected(Game& game, const Action& action) {
+    auto journal = std::make_shared<Journal>();
+    game.gs->setJournal(journal);
+    std::string before = describe(*game.gs);
+    bool thrown = false;
+    try {
+        game.gs->execute(action);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(describe(*game.gs) == before);
+    assert(journal->getActions().empty());
+    assert(!game.gs->canUndo());
+    game.gs->setJournal(nullptr);
+}
+
+void testRejectedActions() {
+    Game game;
+    game.p1->modifyResources(Resources(500, 500, 500, 500));
+    game.gs->addArmy(INFANTRY, 2, 2, game.p1->getIndex(), 1);
+
+    // Moves beyond the army's reach or off the map
+    assertRejected(game, makeAction(MOVE_ARMY, 2, 2, 2, 5));
+    assertRejected(game, makeAction(MOVE_ARMY, 2, 2, 2, -1));
+
+    // Buildings off the map, on tiles of others and on other buildings
+    Action build = makeAction(ADD_BUILDING, 6, 0);
+    build.player = game.p1->getIndex();
+    build.unitType = FARM;
+    assertRejected(game, build);
+    build.x = 5;
+    build.y = 5;
+    assertRejected(game, build);
+    game.gs->addBuilding(Building(FARM, Resources(0, 0, 0, 0),
+                                  Resources(5, 0, 0, 0), game.p1->getIndex(),
+                                  0, 1));
+    build.x = 0;
+    build.y = 1;
+    assertRejected(game, build);
+
+    // Recruiting needs a townhall of one's own
+    Action recruit;
+    recruit.type = PLACE_SOLDIERS;
+    recruit.player = game.p1->getIndex();
+    recruit.unitType = INFANTRY;
+    Game enemyTownhallOnly(false, true);
+    enemyTownhallOnly.p1->modifyResources(Resources(500, 500, 500, 500));
+    assertRejected(enemyTownhallOnly, recruit);
+    Game noTownhalls(false, false);
+    assertRejected(noTownhalls, recruit);
+    std::cout << "testRejectedActions passed." << std::endl;
+}
+
+void testUndoEndsWithTurn() {
+    Game game;
+    game.gs->addArmy(INFANTRY, 1, 1, game.p1->getIndex(), 1);
+    game.gs->execute(makeAction(MOVE_ARMY, 1, 1, 1, 2));
+    assert(game.gs->canUndo());
+    game.gs->nextTurn();
+    assert(!game.gs->canUndo());
+    assert(!game.gs->undo());
+
+    // Failed actions are not logged
+    bool thrown = false;
+    try {
+        game.gs->execute(makeAction(COLONIZE, 4, 4));
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(!game.gs->canUndo());
+    std::cout << "testUndoEndsWithTurn passed." << std::endl;
+}
+
+void testUndoReplay() {
+    Game game;
+    game.gs->addArmy(CAVALRY, 1, 1, game.p1->getIndex(), 3);
+    auto journal = std::make_shared<Journal>();
+    game.gs->setJournal(journal);
+
+    game.gs->execute(makeAction(MOVE_ARMY, 1, 1, 1, 3));
+    game.gs->undo();
+    game.gs->execute(makeAction(MOVE_ARMY, 1, 1, 3, 1));
+    game.gs->execute(makeAction(COLONIZE, 3, 1));
+    game.gs->undo();
+    game.gs->redo();
+    game.gs->nextTurn();
+    assert(game.gs->getTileOwner(3, 1) == game.p1->getIndex());
+
+    auto replayed = std::make_shared<GameState>();
+    Replay replay(replayed, journal);
+    replay.run();
+    assert(describe(*replayed) == describe(*game.gs));
+    std::cout << "testUndoReplay passed." << std::endl;
+}
+
+int main() {
+    testCommandLogCursor();
+    testUndoMove();
+    testUndoCombat();
+    testUndoEconomy();
+    testUndoClampedCharge();
+    testUndoGameover();
+    testUndoGameoverAttackerMoved();
+    testRejectedActions();
+    testUndoEndsWithTurn();
+    testUndoReplay();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "connectedcomponents.hpp"
+#include "gamestate.hpp"
+#include "testutils.hpp"
+
+void testComponentsIslands() {
+    // Two islands separated by a river, 3 rows per column
+    std::vector<uint8_t> terrain = makeTerrain({"GGG", "WWW", "GGG"});
+    ConnectedComponents components;
+    components.build(terrain, 3);
+
+    assert(components.getComponentCount(LAND) == 2);
+    assert(components.getComponentCount(AMPHIBIOUS) == 1);
+    assert(components.isConnected(LAND, 0, 2));
+    assert(!components.isConnected(LAND, 0, 6));
+    assert(components.isConnected(AMPHIBIOUS, 0, 6));
+    assert(components.getComponent(LAND, 4) == -1);
+    assert(!components.isConnected(LAND, 4, 4));
+    std::cout << "testComponentsIslands passed." << std::endl;
+}
+
+void testComponentsRock() {
+    // Rock blocks every movement class
+    std::vector<uint8_t> terrain = makeTerrain({"GGG", "RRR", "GWG"});
+    ConnectedComponents components;
+    components.build(terrain, 3);
+
+    assert(components.getComponentCount(LAND) == 3);
+    assert(components.getComponentCount(AMPHIBIOUS) == 2);
+    assert(!components.isConnected(AMPHIBIOUS, 0, 6));
+    assert(components.isConnected(AMPHIBIOUS, 6, 8));
+    assert(!components.isConnected(LAND, 6, 8));
+    std::cout << "testComponentsRock passed." << std::endl;
+}
+
+void testComponentsUpdate() {
+    std::vector<uint8_t> terrain = makeTerrain({"GGG", "WWW", "GGG"});
+    ConnectedComponents components;
+    components.build(terrain, 3);
+
+    // A bridge joins the islands
+    terrain[4] = GRASS;
+    components.update(terrain, 4, WATER);
+    assert(components.getComponentCount(LAND) == 1);
+    assert(components.isConnected(LAND, 0, 6));
+
+    // Removing it splits them again
+    terrain[4] = ROCK;
+    components.update(terrain, 4, GRASS);
+    assert(components.getComponentCount(LAND) == 2);
+    assert(!components.isConnected(LAND, 0, 6));
+    assert(components.isConnected(AMPHIBIOUS, 0, 6));
+    std::cout << "testComponentsUpdate passed." << std::endl;
+}
+
+void testGameStateCanReach() {
+    GameState gs;
+    gs.loadMapFromString("GGG" "WWW" "GGG", 3);
+
+    assert(gs.canReach(LAND, 0, 0, 0, 2));
+    assert(!gs.canReach(LAND, 0, 0, 2, 0));
+    assert(gs.canReach(AMPHIBIOUS, 0, 0, 2, 0));
+    assert(!gs.canReach(LAND, 0, 0, 3, 0));
+
+    gs.setTileType(1, 1, GRASS);
+    assert(gs.canReach(LAND, 0, 0, 2, 0));
+    std::cout << "testGameStateCanReach passed." << std::endl;
+}
+
+int main() {
+    testComponentsIslands();
+    testComponentsRock();
+    testComponentsUpdate();
+    testGameStateCanReach();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
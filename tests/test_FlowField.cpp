@@ -0,0 +1,100 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "flowfield.hpp"
+#include "gamestate.hpp"
+#include "testutils.hpp"
+
+void testFlowFieldDistance() {
+    // 3 columns of 3 rows, all grass
+    std::vector<uint8_t> terrain = makeTerrain({"GGG", "GGG", "GGG"});
+    FlowField field(terrain, 3, 0, 0, LAND);
+
+    assert(field.getDistance(0, 0) == 0);
+    assert(field.getDistance(1, 0) == 1);
+    assert(field.getDistance(2, 2) == 4);
+    assert(field.getDistance(3, 0) == -1);
+
+    // Every step gets one closer to the target
+    std::pair<int, int> next = field.getNextStep(2, 2);
+    assert(field.getDistance(next.first, next.second) == 3);
+    assert(field.getNextStep(0, 0) == std::make_pair(-1, -1));
+    std::cout << "testFlowFieldDistance passed." << std::endl;
+}
+
+void testFlowFieldObstacles() {
+    // A wall of rock in the middle column with a gap at the bottom
+    std::vector<uint8_t> terrain = makeTerrain({"GGG", "RRG", "GGG"});
+    FlowField field(terrain, 3, 0, 0, LAND);
+
+    assert(field.getDistance(1, 0) == -1);
+    assert(field.getDistance(2, 0) == 6);
+    assert(field.getNextStep(2, 0) == std::make_pair(2, 1));
+
+    int x = 2;
+    int y = 0;
+    int steps = 0;
+    while (field.getDistance(x, y) > 0) {
+        std::tie(x, y) = field.getNextStep(x, y);
+        assert(terrain[x * 3 + y] == GRASS);
+        steps++;
+    }
+    assert(x == 0 && y == 0 && steps == 6);
+    std::cout << "testFlowFieldObstacles passed." << std::endl;
+}
+
+void testFlowFieldMovementClass() {
+    // A river in the middle column only marines can cross
+    std::vector<uint8_t> terrain = makeTerrain({"GGG", "WWW", "GGG"});
+    FlowField land(terrain, 3, 0, 1, LAND);
+    FlowField amphibious(terrain, 3, 0, 1, AMPHIBIOUS);
+
+    assert(land.getDistance(2, 1) == -1);
+    assert(land.getNextStep(2, 1) == std::make_pair(-1, -1));
+    assert(amphibious.getDistance(2, 1) == 2);
+    assert(amphibious.getNextStep(2, 1) == std::make_pair(1, 1));
+    std::cout << "testFlowFieldMovementClass passed." << std::endl;
+}
+
+void testFlowFieldInvalidTarget() {
+    std::vector<uint8_t> terrain = makeTerrain({"GGG", "GGG"});
+    bool thrown = false;
+    try {
+        FlowField field(terrain, 3, 2, 0, LAND);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testFlowFieldInvalidTarget passed." << std::endl;
+}
+
+void testGameStateFlowFieldCache() {
+    GameState gs;
+    gs.loadMapFromString("GGGGGGGGG", 3);
+
+    const FlowField& field = gs.getFlowField(0, 0, LAND);
+    assert(&gs.getFlowField(0, 0, LAND) == &field);
+    assert(&gs.getFlowField(0, 0, AMPHIBIOUS) != &field);
+    assert(gs.getFlowField(0, 0, LAND).getDistance(2, 0) == 2);
+
+    // Changing the terrain drops the cached fields
+    gs.setTileType(1, 0, ROCK);
+    assert(gs.getFlowField(0, 0, LAND).getDistance(2, 0) == 4);
+    std::cout << "testGameStateFlowFieldCache passed." << std::endl;
+}
+
+int main() {
+    testFlowFieldDistance();
+    testFlowFieldObstacles();
+    testFlowFieldMovementClass();
+    testFlowFieldInvalidTarget();
+    testGameStateFlowFieldCache();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
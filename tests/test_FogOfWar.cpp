@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fogofwar.hpp"
+#include "gamestate.hpp"
+
+void testFogOfWarReset() {
+    FogOfWar fog;
+    fog.reset(2, 100);
+    for (int i = 0; i < 100; i++) {
+        assert(!fog.isVisible(0, i));
+        assert(!fog.isVisible(1, i));
+    }
+    std::cout << "testFogOfWarReset passed." << std::endl;
+}
+
+void testFogOfWarAddViewer() {
+    FogOfWar fog;
+    fog.reset(2, 130);
+    fog.addViewer(0, 0);
+    fog.addViewer(0, 64);
+    fog.addViewer(1, 129);
+
+    assert(fog.isVisible(0, 0));
+    assert(fog.isVisible(0, 64));
+    assert(!fog.isVisible(0, 63));
+    assert(!fog.isVisible(0, 129));
+    assert(fog.isVisible(1, 129));
+    assert(!fog.isVisible(1, 0));
+    std::cout << "testFogOfWarAddViewer passed." << std::endl;
+}
+
+void testFogOfWarRemoveViewer() {
+    FogOfWar fog;
+    fog.reset(1, 10);
+    assert(fog.addViewer(0, 5));
+    assert(!fog.addViewer(0, 5));
+
+    assert(!fog.removeViewer(0, 5));
+    assert(fog.isVisible(0, 5));
+    assert(fog.removeViewer(0, 5));
+    assert(!fog.isVisible(0, 5));
+
+    // Removing more viewers than were added must not underflow
+    assert(!fog.removeViewer(0, 5));
+    fog.addViewer(0, 5);
+    assert(fog.isVisible(0, 5));
+    std::cout << "testFogOfWarRemoveViewer passed." << std::endl;
+}
+
+void testFogOfWarOutOfRange() {
+    FogOfWar fog;
+    fog.reset(1, 10);
+    fog.addViewer(0, 9);
+    assert(!fog.isVisible(-1, 9));
+    assert(!fog.isVisible(1, 9));
+    assert(!fog.isVisible(0, 10));
+    assert(!fog.isVisible(0, -1));
+    std::cout << "testFogOfWarOutOfRange passed." << std::endl;
+}
+
+void testGameStateMapRevision() {
+    GameState gs;
+    auto player = std::make_shared<Player>(Color::Red, 1);
+    gs.addPlayer(player);
+    gs.loadMapFromString(std::string(16, 'G'), 4);
+    gs.getVisibleXY(player);
+
+    // Looking at the map changes nothing
+    uint64_t revision = gs.getMapRevision();
+    gs.getVisibleXY(player);
+    gs.getTileOwner(1, 1);
+    assert(gs.getMapRevision() == revision);
+
+    std::vector<int> tiles;
+    assert(gs.getChangedTiles(revision, tiles) && tiles.empty());
+
+    // The claimed tile and the tiles it reveals
+    gs.claimTile(1, 1, player);
+    assert(gs.getMapRevision() != revision);
+    assert(gs.getChangedTiles(revision, tiles));
+    assert(tiles.size() == 10);
+    assert(std::count(tiles.begin(), tiles.end(), 1 * 4 + 1) == 2);
+    revision = gs.getMapRevision();
+    gs.setTileType(3, 3, WATER);
+    assert(gs.getChangedTiles(revision, tiles));
+    assert((tiles == std::vector<int>{3 * 4 + 3}));
+    revision = gs.getMapRevision();
+    gs.addArmy(INFANTRY, 0, 3, player->getIndex(), 1);
+    assert(gs.getMapRevision() != revision);
+
+    // Loading a map changes every tile
+    uint64_t beforeLoad = gs.getMapRevision();
+    gs.loadMapFromString(std::string(16, 'W'), 4);
+    assert(!gs.getChangedTiles(beforeLoad, tiles));
+    std::cout << "testGameStateMapRevision passed." << std::endl;
+}
+
+int main() {
+    testFogOfWarReset();
+    testFogOfWarAddViewer();
+    testFogOfWarRemoveViewer();
+    testFogOfWarOutOfRange();
+    testGameStateMapRevision();
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gamestate.hpp"
+
+// Three players on a 6 x 6 grass map, each with a townhall, some land and
+// buildings. The farm of p2 is the first building, so erasing it moves all
+// the others.
+struct Game {
+    std::shared_ptr<GameState> gs = std::make_shared<GameState>();
+    std::shared_ptr<Player> p1 = std::make_shared<Player>(Color::Red, 1);
+    std::shared_ptr<Player> p2 = std::make_shared<Player>(Color::Blue, 2);
+    std::shared_ptr<Player> p3 = std::make_shared<Player>(Color::Green, 3);
+    std::vector<std::shared_ptr<Player>> players = {p1, p2, p3};
+
+    Game() {
+        for (const std::shared_ptr<Player>& p : players) gs->addPlayer(p);
+        gs->loadMapFromString(std::string(36, 'G'), 6);
+        claimTiles(p1, {{0, 0}, {0, 1}, {1, 0}});
+        claimTiles(p2, {{5, 5}, {5, 4}, {4, 5}, {4, 4}, {3, 5}});
+        claimTiles(p3, {{0, 5}, {0, 4}});
+        gs->addTownhall(TownHall(1, 1, p1->getIndex(), 0, 0));
+        gs->addTownhall(TownHall(2, 1, p2->getIndex(), 5, 5));
+        gs->addTownhall(TownHall(3, 1, p3->getIndex(), 0, 5));
+        addBuilding(FARM, p2, 5, 4);
+        addBuilding(MINE, p1, 0, 1);
+        addBuilding(WOOD_CUTTER, p2, 4, 5);
+        addBuilding(MARKET, p3, 0, 4);
+        gs->setActivePlayerID(p1->getID());
+    }
+
+    void claimTiles(const std::shared_ptr<Player>& owner,
+                    const std::vector<std::pair<int, int>>& tiles) {
+        for (auto [x, y] : tiles) gs->claimTile(x, y, owner);
+    }
+
+    void addBuilding(BuildingType type, const std::shared_ptr<Player>& owner,
+                     int x, int y) {
+        gs->addBuilding(Building(type, Resources(0, 0, 0, 0),
+                                 getBuildingProduction(type),
+                                 owner->getIndex(), x, y));
+    }
+};
+
+Action makeAction(ActionType type, int x, int y, int toX = 0, int toY = 0) {
+    Action action;
+    action.type = type;
+    action.x = x;
+    action.y = y;
+    action.toX = toX;
+    action.toY = toY;
+    return action;
+}
+
+// The army, building and townhall grids point at what a scan finds on each
+// tile
+void checkOccupancy(Game& game) {
+    GameState& gs = *game.gs;
+    int numRows = gs.getNumRows();
+    std::vector<int> armies(gs.getNumCols() * numRows, 0);
+    std::vector<int> buildings(armies.size(), 0);
+    std::vector<int> townhalls(armies.size(), 0);
+
+    for (const std::shared_ptr<Player>& p : game.players) {
+        for (ArmyHandle handle : gs.getPlayerArmies(p)) {
+            Army* army = gs.getArmy(handle);
+            assert(army != nullptr && army->getOwner() == p->getIndex());
+            int x = army->getLocationX();
+            int y = army->getLocationY();
+            armies[x * numRows + y]++;
+            assert(gs.findArmyByLocation(x, y) == handle);
+            assert(&gs.getArmyByLocation(x, y) == army);
+        }
+    }
+    for (const Building& building : gs.getBuildings()) {
+        int x = building.getX();
+        int y = building.getY();
+        buildings[x * numRows + y]++;
+        assert(&*gs.findBuildingByLocation(x, y) == &building);
+    }
+    for (const TownHall& townhall : gs.getTownhalls()) {
+        int x = townhall.getX();
+        int y = townhall.getY();
+        townhalls[x * numRows + y]++;
+        assert(&*gs.findTownhallByLocation(x, y) == &townhall);
+        assert(gs.getTownhallOwner(x, y) == townhall.getOwner());
+    }
+
+    for (int x = 0; x < gs.getNumCols(); x++) {
+        for (int y = 0; y < numRows; y++) {
+            int i = x * numRows + y;
+            assert(armies[i] <= 1 && buildings[i] <= 1 && townhalls[i] <= 1);
+            assert(gs.tileHasArmy(x, y) == (armies[i] == 1));
+            assert(gs.tileHasBuilding(x, y) == (buildings[i] == 1));
+            if (townhalls[i] == 0) {
+                assert(gs.getTownhallOwner(x, y) == NO_PLAYER);
+            }
+        }
+    }
+}
+
+// The owned tile lists hold the tiles a scan of the owners finds
+void checkOwnedTiles(Game& game) {
+    GameState& gs = *game.gs;
+    for (const std::shared_ptr<Player>& p : game.players) {
+        std::vector<std::pair<int, int>> owned;
+        std::vector<std::pair<int, int>> free;
+        for (int x = 0; x < gs.getNumCols(); x++) {
+            for (int y = 0; y < gs.getNumRows(); y++) {
+                if (gs.getTileOwner(x, y) != p->getIndex()) continue;
+                owned.emplace_back(x, y);
+                if (!gs.tileHasBuilding(x, y) &&
+                    gs.getTownhallOwner(x, y) == NO_PLAYER)
+                    free.emplace_back(x, y);
+            }
+        }
+
+        assert(gs.getClaimedTileCount(p) == int(owned.size()));
+        std::vector<std::pair<int, int>> claimed;
+        for (const Tile& tile : gs.getClaimedTiles(p))
+            claimed.emplace_back(tile.getX(), tile.getY());
+        std::sort(claimed.begin(), claimed.end());
+        assert(claimed == owned);
+        std::vector<std::pair<int, int>> claimedFree =
+            gs.getFreeClaimedTiles(p);
+        std::sort(claimedFree.begin(), claimedFree.end());
+        assert(claimedFree == free);
+    }
+}
+
+bool sameResources(const Resources& a, const Resources& b) {
+    return a.food == b.food && a.wood == b.wood && a.gold == b.gold &&
+           a.stone == b.stone;
+}
+
+// The income and building counts add up what a scan of the buildings finds
+void checkIncome(Game& game) {
+    GameState& gs = *game.gs;
+    for (const std::shared_ptr<Player>& p : game.players) {
+        Resources total(0, 0, 0, 0);
+        for (int type = 0; type < NUM_BUILDING_TYPES; type++) {
+            int count = 0;
+            for (const Building& building : gs.getBuildings()) {
+                if (building.getOwner() == p->getIndex() &&
+                    building.getType() == type)
+                    count++;
+            }
+            Resources gain = getBuildingProduction(BuildingType(type));
+            Resources income(count * gain.food, count * gain.wood,
+                             count * gain.gold, count * gain.stone);
+            assert(gs.getBuildingCount(p, BuildingType(type)) == count);
+            assert(sameResources(gs.getIncome(p, BuildingType(type)), income));
+            total.food += income.food;
+            total.wood += income.wood;
+            total.gold += income.gold;
+            total.stone += income.stone;
+        }
+        assert(sameResources(gs.getIncome(p), total));
+    }
+}
+
+void checkIndexes(Game& game) {
+    checkOccupancy(game);
+    checkOwnedTiles(game);
+    checkIncome(game);
+}
+
+void testIndexesThroughUndo() {
+    Game game;
+    GameState& gs = *game.gs;
+    PlayerIndex p1 = game.p1->getIndex();
+    PlayerIndex p2 = game.p2->getIndex();
+    PlayerIndex p3 = game.p3->getIndex();
+    gs.addArmy(INFANTRY, 2, 2, p1, 3);
+    gs.addArmy(INFANTRY, 2, 3, p1, 2);
+    gs.addArmy(ARTILLERY, 3, 2, p1, 20);
+    gs.addArmy(INFANTRY, 3, 3, p2, 1);
+    gs.addArmy(CAVALRY, 5, 4, p1, 5);
+    gs.addArmy(CAVALRY, 1, 1, p1, 4);
+    gs.addArmy(CAVALRY, 3, 5, p1, 3);
+    gs.addArmy(INFANTRY, 4, 3, p2, 2);
+    gs.addArmy(INFANTRY, 5, 5, p1, 2);
+    gs.addArmy(INFANTRY, 1, 4, p3, 2);
+    checkIndexes(game);
+
+    // Merge
+    gs.execute(makeAction(MOVE_ARMY, 2, 2, 2, 3));
+    assert(gs.getArmyByLocation(2, 3).getUnitCount() == 5);
+    checkIndexes(game);
+    // Combat the artillery wins
+    gs.execute(makeAction(MOVE_ARMY, 3, 2, 3, 3));
+    assert(gs.getArmyByLocation(3, 3).getOwner() == p1);
+    checkIndexes(game);
+    // Free tile
+    gs.execute(makeAction(COLONIZE, 1, 1));
+    assert(gs.getTileOwner(1, 1) == p1);
+    checkIndexes(game);
+    // The farm of p2 is erased from the front of the buildings
+    gs.execute(makeAction(COLONIZE, 5, 4));
+    assert(!gs.tileHasBuilding(5, 4));
+    assert(gs.getTileOwner(5, 4) == NO_PLAYER);
+    checkIndexes(game);
+    // The last tile of p2 took the place of the freed one in its list
+    gs.execute(makeAction(COLONIZE, 3, 5));
+    assert(gs.getTileOwner(3, 5) == NO_PLAYER);
+    checkIndexes(game);
+    // Taking the townhall of p2 ends its game
+    gs.execute(makeAction(COLONIZE, 5, 5));
+    assert(!game.p2->getIsAlive());
+    assert(!gs.tileHasArmy(4, 3) && !gs.tileHasBuilding(4, 5));
+    checkIndexes(game);
+
+    int undone = 0;
+    while (gs.undo()) {
+        checkIndexes(game);
+        undone++;
+    }
+    assert(undone == 6);
+    assert(game.p2->getIsAlive() && gs.tileHasBuilding(5, 4));
+    while (gs.redo()) checkIndexes(game);
+    assert(!game.p2->getIsAlive());
+    std::cout << "testIndexesThroughUndo passed." << std::endl;
+}
+
+void testIncomeByType() {
+    Game game;
+    GameState& gs = *game.gs;
+    game.addBuilding(FARM, game.p2, 4, 4);
+    game.addBuilding(WOOD_CUTTER, game.p1, 1, 0);
+
+    // Two farms and a wood cutter
+    assert(gs.getBuildingCount(game.p2, FARM) == 2);
+    assert(gs.getIncome(game.p2, FARM).food == 40);
+    assert(gs.getIncome(game.p2, WOOD_CUTTER).wood == 20);
+    assert(gs.getIncome(game.p2, MARKET).gold == 0);
+    assert(gs.getIncome(game.p2).food == 40);
+    assert(gs.getIncome(game.p2).wood == 20);
+    assert(gs.getIncome(game.p1, WOOD_CUTTER).wood == 20);
+    assert(gs.getIncome(game.p1, MINE).stone == 20);
+    checkIncome(game);
+
+    // A player that is not in the game has no income
+    std::shared_ptr<Player> stranger =
+        std::make_shared<Player>(Color::Red, 9);
+    assert(gs.getBuildingCount(stranger, FARM) == 0);
+    assert(sameResources(gs.getIncome(stranger, FARM),
+                         Resources(0, 0, 0, 0)));
+    std::cout << "testIncomeByType passed." << std::endl;
+}
+
+int main() {
+    testIndexesThroughUndo();
+    testIncomeByType();
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <cassert>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "grid.hpp"
+
+std::vector<std::pair<int, int>> collect4(int x, int y, int radius) {
+    std::vector<std::pair<int, int>> tiles;
+    forEachNeighbour<FOUR_CONNECTED>(x, y, radius, 10, 8, [&](int nx, int ny) {
+        tiles.push_back({nx, ny});
+    });
+    return tiles;
+}
+
+std::vector<std::pair<int, int>> collect8(int x, int y, int radius) {
+    std::vector<std::pair<int, int>> tiles;
+    forEachNeighbour<EIGHT_CONNECTED>(x, y, radius, 10, 8, [&](int nx, int ny) {
+        tiles.push_back({nx, ny});
+    });
+    return tiles;
+}
+
+void testNeighbourCounts() {
+    static_assert(neighbourCount<FOUR_CONNECTED, 1>() == 4);
+    static_assert(neighbourCount<FOUR_CONNECTED, 2>() == 12);
+    static_assert(neighbourCount<EIGHT_CONNECTED, 1>() == 8);
+    static_assert(neighbourCount<EIGHT_CONNECTED, 2>() == 24);
+
+    // Away from the border every neighbour is visited
+    assert(collect4(5, 4, 1).size() == 4);
+    assert(collect4(5, 4, 2).size() == 12);
+    assert(collect4(5, 4, 3).size() == 24);
+    assert(collect8(5, 4, 1).size() == 8);
+    assert(collect8(5, 4, 3).size() == 48);
+    assert(collect8(5, 4, 0).empty());
+    std::cout << "testNeighbourCounts passed." << std::endl;
+}
+
+void testNeighbourOrder() {
+    // Neighbours come ordered by x, then y
+    std::vector<std::pair<int, int>> four = {{4, 4}, {5, 3}, {5, 5}, {6, 4}};
+    assert(collect4(5, 4, 1) == four);
+
+    std::vector<std::pair<int, int>> eight = {
+        {4, 3}, {4, 4}, {4, 5}, {5, 3}, {5, 5}, {6, 3}, {6, 4}, {6, 5}};
+    assert(collect8(5, 4, 1) == eight);
+    std::cout << "testNeighbourOrder passed." << std::endl;
+}
+
+void testNeighbourBorder() {
+    // Corners and edges skip the tiles off the map
+    assert(collect4(0, 0, 1).size() == 2);
+    assert(collect8(0, 0, 1).size() == 3);
+    assert(collect8(9, 7, 1).size() == 3);
+    assert(collect8(0, 4, 1).size() == 5);
+    assert(collect4(0, 0, 3).size() == 9);
+    for (auto [x, y] : collect8(9, 0, 4)) {
+        assert(x >= 0 && x < 10 && y >= 0 && y < 8);
+    }
+    std::cout << "testNeighbourBorder passed." << std::endl;
+}
+
+int main() {
+    testNeighbourCounts();
+    testNeighbourOrder();
+    testNeighbourBorder();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
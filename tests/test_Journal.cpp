@@ -0,0 +1,171 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gamestate.hpp"
+#include "journal.hpp"
+#include "playerAI.hpp"
+#include "replay.hpp"
+#include "testutils.hpp"
+
+std::string tempFile(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void testJournalSaveLoad() {
+    Journal journal;
+    journal.begin(42, {{true, Color::Red}, {false, Color(1, 2, 3, 4)}},
+                  {9, 8, 7});
+
+    Action move;
+    move.type = MOVE_ARMY;
+    move.x = 1;
+    move.y = 2;
+    move.toX = 3;
+    move.toY = -4;
+    Action build;
+    build.type = ADD_BUILDING;
+    build.x = 5;
+    build.y = 6;
+    build.player = 1;
+    build.unitType = MINE;
+    build.cost = Resources(1, 2, 3, 4);
+    build.gain = Resources(5, 6, 7, 8);
+    Action soldiers;
+    soldiers.type = PLACE_SOLDIERS;
+    soldiers.player = 0;
+    soldiers.unitType = MARINE;
+    journal.record(move);
+    journal.record(build);
+    journal.record(soldiers);
+    journal.record(Action());
+
+    std::string filename = tempFile("test_Journal.s8j");
+    journal.save(filename);
+    Journal loaded = Journal::load(filename);
+    std::remove(filename.c_str());
+
+    assert(loaded.getSeed() == 42);
+    assert(loaded.getPlayers().size() == 2);
+    assert(loaded.getPlayers()[0].isComputer);
+    assert(loaded.getPlayers()[1].color == Color(1, 2, 3, 4));
+    assert((loaded.getSnapshot() == std::vector<uint8_t>{9, 8, 7}));
+    assert(loaded.getActions().size() == 4);
+    assert(loaded.getTurnCount() == 1);
+    const Action& m = loaded.getActions()[0];
+    assert(m.type == MOVE_ARMY && m.x == 1 && m.y == 2 && m.toX == 3 &&
+           m.toY == -4);
+    const Action& b = loaded.getActions()[1];
+    assert(b.type == ADD_BUILDING && b.player == 1 && b.unitType == MINE);
+    assert(b.cost.stone == 4 && b.gain.food == 5);
+    assert(loaded.getActions()[2].unitType == MARINE);
+    assert(loaded.getActions()[3].type == NEXT_TURN);
+    std::cout << "testJournalSaveLoad passed." << std::endl;
+}
+
+// Two AI players on a small map, set up like selfplay does
+std::shared_ptr<GameState> makeMatch(uint64_t seed) {
+    auto gs = std::make_shared<GameState>();
+    gs->setSeed(seed);
+    std::vector<std::shared_ptr<PlayerAI>> players;
+    for (int i = 0; i < 2; i++) {
+        auto player = std::make_shared<PlayerAI>(Color::Red, i + 1, gs);
+        player->addSharedPtr(player);
+        player->setTurnDelay(std::chrono::milliseconds(0));
+        gs->addPlayer(player);
+        players.push_back(player);
+    }
+    std::string map;
+    for (int x = 0; x < 12; x++) {
+        map += x == 5 || x == 6 ? "GGGGWWWWGGGG" : "GGGGGGGGGGGG";
+    }
+    gs->loadMapFromString(map, 12);
+    gs->claimTile(2, 2, players[0]);
+    gs->claimTile(9, 9, players[1]);
+    gs->addTownhall(TownHall(1, 1, players[0]->getIndex(), 2, 2));
+    gs->addTownhall(TownHall(2, 1, players[1]->getIndex(), 9, 9));
+    gs->setActivePlayerID(players[1]->getID());
+    return gs;
+}
+
+void testJournalReplay() {
+    std::shared_ptr<GameState> original = makeMatch(3);
+    auto journal = std::make_shared<Journal>();
+    original->setJournal(journal);
+    for (int i = 0; i < 300 && !original->getWinner(); i++) original->tick();
+    original->setJournal(nullptr);
+
+    assert(journal->getSeed() == 3);
+    assert(journal->getTurnCount() == original->getTurn() - 1);
+    assert(journal->getActions().size() > size_t(journal->getTurnCount()));
+
+    // Replaying does not run the AI but ends up in the same game
+    auto replayed = std::make_shared<GameState>();
+    Replay replay(replayed, journal);
+    assert(replayed->getTurn() == 1);
+    assert(replay.stepTurn());
+    assert(replayed->getTurn() == 2);
+    replay.run();
+    assert(replay.isFinished());
+    assert(!replay.stepTurn());
+    assert(replayed->getPlayer(0)->isComputer());
+    assert(describe(*replayed) == describe(*original));
+    std::cout << "testJournalReplay passed." << std::endl;
+}
+
+void testJournalHumanActions() {
+    auto gs = std::make_shared<GameState>();
+    auto human = std::make_shared<Player>(Color::Green, 1);
+    auto other = std::make_shared<Player>(Color::Blue, 2);
+    gs->addPlayer(human);
+    gs->addPlayer(other);
+    gs->loadMapFromString(std::string(25, 'G'), 5);
+    gs->addTownhall(TownHall(1, 1, human->getIndex(), 0, 0));
+    gs->addArmy(CAVALRY, 2, 2, human->getIndex(), 3);
+
+    auto journal = std::make_shared<Journal>();
+    gs->setJournal(journal);
+    gs->moveArmy(gs->getArmyByLocation(2, 2), 3, 3);
+    gs->colonize(gs->getArmyByLocation(3, 3));
+    gs->placeSoldiers(human, INFANTRY);
+    gs->incrementArmyUnit(gs->getArmyByLocation(3, 3));
+    gs->nextTurn();
+    assert(journal->getActions().size() == 5);
+    assert(!journal->getPlayers()[0].isComputer);
+
+    auto replayed = std::make_shared<GameState>();
+    Replay replay(replayed, journal);
+    replay.run();
+    assert(!replayed->getPlayer(0)->isComputer());
+    assert(describe(*replayed) == describe(*gs));
+    assert(replayed->getTileOwner(3, 3) == 0);
+
+    // An action that does not fit the game
+    Action move;
+    move.type = MOVE_ARMY;
+    move.x = 4;
+    move.y = 4;
+    bool thrown = false;
+    try {
+        replayed->applyAction(move);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testJournalHumanActions passed." << std::endl;
+}
+
+int main() {
+    testJournalSaveLoad();
+    testJournalReplay();
+    testJournalHumanActions();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "gamestate.hpp"
+#include "mapfile.hpp"
+
+// Returns true if parsing the text throws std::invalid_argument
+bool isRejected(const std::string& text) {
+    try {
+        MapFile::parse(text);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void testMapFileHeader() {
+    MapFile map = MapFile::parse("MAP 1 3 2\nGW\nRG\r\nNG\n");
+    assert(map.getNumCols() == 3);
+    assert(map.getNumRows() == 2);
+    assert(map.getTiles() == "GWRGNG");
+    assert(map.toString() == "MAP 1 3 2\nGW\nRG\nNG\n");
+    std::cout << "testMapFileHeader passed." << std::endl;
+}
+
+void testMapFileLegacy() {
+    // Without a header the rows come from the length of the columns
+    MapFile map = MapFile::parse("GGW\nWGG\n");
+    assert(map.getNumCols() == 2);
+    assert(map.getNumRows() == 3);
+    assert(map.getTiles() == "GGWWGG");
+
+    MapFile empty = MapFile::parse("");
+    assert(empty.getNumCols() == 0);
+    assert(empty.getTiles().empty());
+    std::cout << "testMapFileLegacy passed." << std::endl;
+}
+
+void testMapFileInvalid() {
+    assert(isRejected("MAP 2 1 2\nGG\n"));
+    assert(isRejected("MAP 1 2\nGG\n"));
+    assert(isRejected("MAP 1 2 2\nGG\n"));
+    assert(isRejected("MAP 1 1 2\nGGG\n"));
+    assert(isRejected("MAP 1 1 2\nGX\n"));
+    assert(isRejected("GG\nGGG\n"));
+
+    bool thrown = false;
+    try {
+        MapFile(2, 2, "GGG");
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testMapFileInvalid passed." << std::endl;
+}
+
+void testMapFileSaveLoad() {
+    std::string filename =
+        (std::filesystem::temp_directory_path() / "test_MapFile.txt").string();
+    MapFile(2, 3, "GWRNGG").save(filename);
+    MapFile map = MapFile::load(filename);
+    std::remove(filename.c_str());
+    assert(map.getNumCols() == 2);
+    assert(map.getNumRows() == 3);
+    assert(map.getTiles() == "GWRNGG");
+
+    bool thrown = false;
+    try {
+        MapFile::load(filename);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testMapFileSaveLoad passed." << std::endl;
+}
+
+void testGameStateLoadLargeMap() {
+    // 600 columns of 512 tiles, with a river along the last row
+    std::string text = "MAP 1 600 512\n";
+    for (int x = 0; x < 600; x++) text += std::string(511, 'G') + "W\n";
+
+    GameState gs;
+    gs.loadMap(MapFile::parse(text));
+    assert(gs.getNumCols() == 600);
+    assert(gs.getNumRows() == 512);
+    assert(gs.areCoordinatesValid(599, 511));
+    assert(!gs.areCoordinatesValid(600, 0));
+    assert(!gs.areCoordinatesValid(0, 512));
+    assert(gs.getTileType(599, 511) == WATER);
+    assert(gs.getTileType(599, 510) == GRASS);
+    assert(gs.canReach(LAND, 0, 0, 599, 510));
+    std::cout << "testGameStateLoadLargeMap passed." << std::endl;
+}
+
+int main() {
+    testMapFileHeader();
+    testMapFileLegacy();
+    testMapFileInvalid();
+    testMapFileSaveLoad();
+    testGameStateLoadLargeMap();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gamestate.hpp"
+#include "mapfile.hpp"
+#include "mappedmap.hpp"
+
+std::string tempFile(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Returns true if mapping the file throws std::invalid_argument
+bool isRejected(const std::string& filename) {
+    try {
+        MappedMap map(filename);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void testMappedMapTerrain() {
+    std::string filename = tempFile("test_MappedMap_terrain.s8m");
+    std::vector<uint8_t> terrain = {GRASS, WATER, ROCK, GRASS, GRASS, WATER};
+    MappedMap::save(filename, 2, 3, terrain);
+
+    assert(MappedMap::isBinaryMap(filename));
+    {
+        MappedMap map(filename);
+        assert(map.getNumCols() == 2);
+        assert(map.getNumRows() == 3);
+        assert(std::vector<uint8_t>(map.getTerrain(), map.getTerrain() + 6) ==
+               terrain);
+        assert(map.getOwners() == nullptr);
+    }
+    std::remove(filename.c_str());
+    std::cout << "testMappedMapTerrain passed." << std::endl;
+}
+
+void testMappedMapInvalid() {
+    std::string filename = tempFile("test_MappedMap_invalid.s8m");
+
+    // Text maps are not binary maps
+    MapFile(1, 2, "GW").save(filename);
+    assert(!MappedMap::isBinaryMap(filename));
+    assert(isRejected(filename));
+
+    // Truncated layer
+    MappedMap::save(filename, 2, 2, {GRASS, GRASS, GRASS, GRASS});
+    std::filesystem::resize_file(filename, 22);
+    assert(isRejected(filename));
+
+    // Unknown tile type
+    MappedMap::save(filename, 1, 1, {42});
+    assert(isRejected(filename));
+    std::remove(filename.c_str());
+
+    bool thrown = false;
+    try {
+        MappedMap map(filename);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(!MappedMap::isBinaryMap(filename));
+    std::cout << "testMappedMapInvalid passed." << std::endl;
+}
+
+void testGameStateBinaryMap() {
+    // Converted from text the terrain matches loading the text directly
+    MapFile text = MapFile::parse("MAP 1 3 2\nGW\nRN\nGG\n");
+    std::string filename = tempFile("test_MappedMap_game.s8m");
+    MappedMap::save(filename, text.getNumCols(), text.getNumRows(),
+                    text.toTerrain());
+
+    GameState fromText;
+    fromText.loadMap(text);
+    GameState fromBinary;
+    fromBinary.loadMap(MappedMap(filename));
+    assert(fromBinary.getNumCols() == 3);
+    assert(fromBinary.getNumRows() == 2);
+    for (int x = 0; x < 3; x++) {
+        for (int y = 0; y < 2; y++) {
+            assert(fromBinary.getTileType(x, y) ==
+                   fromText.getTileType(x, y));
+            assert(fromBinary.getTileOwner(x, y) == NO_PLAYER);
+        }
+    }
+
+    // Saving keeps the ownership layer
+    std::shared_ptr<Player> player =
+        std::make_shared<Player>(Color::Red, 1);
+    GameState gs;
+    gs.addPlayer(player);
+    gs.loadMap(text);
+    gs.claimTile(2, 1, player);
+    gs.saveMap(filename);
+
+    GameState loaded;
+    loaded.addPlayer(std::make_shared<Player>(Color::Red, 1));
+    loaded.loadMap(MappedMap(filename));
+    std::remove(filename.c_str());
+    assert(loaded.getTileType(0, 1) == WATER);
+    assert(loaded.getTileOwner(2, 1) == player->getIndex());
+    assert(loaded.getTileOwner(2, 0) == NO_PLAYER);
+    assert(loaded.getClaimedTileCount(loaded.getPlayer(0)) == 1);
+    std::cout << "testGameStateBinaryMap passed." << std::endl;
+}
+
+int main() {
+    testMappedMapTerrain();
+    testMappedMapInvalid();
+    testGameStateBinaryMap();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
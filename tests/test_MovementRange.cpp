@@ -0,0 +1,158 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gamestate.hpp"
+#include "movementrange.hpp"
+
+using Tiles = std::vector<std::pair<int, int>>;
+
+void testMovementRangeOpenField() {
+    // 5 x 5 map where every step costs 1
+    auto stepCost = [](int, int, int, int) { return 1; };
+    auto stopsAt = [](int, int) { return false; };
+    MovementRange range(2, 2, 2, 5, 5, stepCost, stopsAt);
+
+    assert(range.getTiles().size() == 12);
+    assert(!range.contains(2, 2));
+    assert(range.getCost(2, 2) == 0);
+    assert(range.contains(2, 4));
+    assert(range.getCost(3, 3) == 2);
+    assert(!range.contains(3, 4));
+    assert(range.getCost(3, 4) == -1);
+
+    Tiles path = range.getPath(2, 0);
+    assert((path == Tiles{{2, 1}, {2, 0}}));
+    assert(range.getPath(0, 0).empty());
+    std::cout << "testMovementRangeOpenField passed." << std::endl;
+}
+
+void testMovementRangeObstacles() {
+    // Column 1 is blocked except for its last row, so the long way round is
+    // the only way to the other side
+    auto stepCost = [](int, int, int toX, int toY) {
+        return toX == 1 && toY != 2 ? -1 : 1;
+    };
+    auto stopsAt = [](int, int) { return false; };
+    MovementRange range(0, 0, 4, 3, 3, stepCost, stopsAt);
+
+    assert(range.getCost(2, 0) == -1);
+    assert(range.getCost(2, 2) == 4);
+    assert((range.getPath(2, 2) == Tiles{{0, 1}, {0, 2}, {1, 2}, {2, 2}}));
+    assert(!range.contains(1, 0));
+
+    // Stopping tiles can be entered but not passed through
+    auto stopsAtGap = [](int x, int y) { return x == 1 && y == 2; };
+    MovementRange stopped(0, 0, 4, 3, 3, stepCost, stopsAtGap);
+    assert(stopped.contains(1, 2));
+    assert(!stopped.contains(2, 2));
+    std::cout << "testMovementRangeObstacles passed." << std::endl;
+}
+
+void testMovementRangeEmpty() {
+    MovementRange range;
+    assert(range.getTiles().empty());
+    assert(!range.contains(0, 0));
+    assert(range.getCost(0, 0) == -1);
+    std::cout << "testMovementRangeEmpty passed." << std::endl;
+}
+
+struct Game {
+    GameState gs;
+    std::shared_ptr<Player> p1 = std::make_shared<Player>(Color::Red, 1);
+    std::shared_ptr<Player> p2 = std::make_shared<Player>(Color::Blue, 2);
+
+    // Map of 5 columns with 5 rows each
+    explicit Game(const std::string& map) {
+        gs.addPlayer(p1);
+        gs.addPlayer(p2);
+        gs.loadMapFromString(map, 5);
+    }
+};
+
+void testArmySpeed() {
+    Game game("GGGGG" "GGGGG" "GGGGG" "GGGGG" "GGGGG");
+    game.gs.addArmy(INFANTRY, 2, 2, game.p1->getIndex(), 1);
+    game.gs.addArmy(CAVALRY, 0, 0, game.p1->getIndex(), 1);
+
+    Army& infantry = game.gs.getArmyByLocation(2, 2);
+    Army& cavalry = game.gs.getArmyByLocation(0, 0);
+    assert(infantry.getSpeed() == 1);
+    assert(cavalry.getSpeed() == 2);
+    assert(game.gs.getArmyMovementRange(infantry).size() == 4);
+    assert(game.gs.getArmyMovementRange(cavalry).size() == 5);
+    assert(game.gs.isArmyWithinMovementRange(cavalry, 1, 1));
+    assert(!game.gs.isArmyWithinMovementRange(infantry, 3, 3));
+
+    // Cavalry moves two tiles in one go
+    game.gs.moveArmy(cavalry, 0, 2);
+    assert(game.gs.tileHasArmy(0, 2));
+    assert(!game.gs.tileHasArmy(0, 0));
+    assert(game.gs.getArmyMovementRange(game.gs.getArmyByLocation(0, 2))
+               .empty());
+    std::cout << "testArmySpeed passed." << std::endl;
+}
+
+void testArmyTerrain() {
+    // Column 1 is a river
+    Game game("GGGGG" "WWWWW" "GGGGG" "GGGGG" "GGGGG");
+    game.gs.addArmy(CAVALRY, 0, 2, game.p1->getIndex(), 1);
+    game.gs.addArmy(MARINE, 0, 0, game.p1->getIndex(), 1);
+
+    Army& cavalry = game.gs.getArmyByLocation(0, 2);
+    assert(!game.gs.isArmyWithinMovementRange(cavalry, 1, 2));
+    assert(!game.gs.isArmyWithinMovementRange(cavalry, 2, 2));
+
+    Army& marine = game.gs.getArmyByLocation(0, 0);
+    assert(game.gs.isArmyWithinMovementRange(marine, 2, 0));
+    MovementRange range = game.gs.getMovementRange(marine);
+    assert((range.getPath(2, 0) == Tiles{{1, 0}, {2, 0}}));
+    std::cout << "testArmyTerrain passed." << std::endl;
+}
+
+void testArmyBlocking() {
+    Game game("GGGGG" "GGGGG" "GGGGG" "GGGGG" "GGGGG");
+    game.gs.addArmy(CAVALRY, 0, 0, game.p1->getIndex(), 1);
+    game.gs.addArmy(INFANTRY, 1, 0, game.p2->getIndex(), 1);
+    game.gs.addArmy(INFANTRY, 0, 1, game.p1->getIndex(), 1);
+
+    Army& cavalry = game.gs.getArmyByLocation(0, 0);
+    // The enemy can be attacked but not passed
+    assert(game.gs.isArmyWithinMovementRange(cavalry, 1, 0));
+    assert(!game.gs.isArmyWithinMovementRange(cavalry, 2, 0));
+    // Own armies of another type cannot be entered
+    assert(!game.gs.isArmyWithinMovementRange(cavalry, 0, 1));
+    // Both ways to 1, 1 lead through one of the armies
+    assert(!game.gs.isArmyWithinMovementRange(cavalry, 1, 1));
+    std::cout << "testArmyBlocking passed." << std::endl;
+}
+
+void testArmyEnemyTerritory() {
+    Game game("GGGGG" "GGGGG" "GGGGG" "GGGGG" "GGGGG");
+    game.gs.claimTile(1, 0, game.p2);
+    game.gs.claimTile(2, 0, game.p2);
+    game.gs.addArmy(CAVALRY, 0, 0, game.p1->getIndex(), 1);
+
+    // Entering enemy territory ends the advance into it for this turn
+    Army& cavalry = game.gs.getArmyByLocation(0, 0);
+    assert(game.gs.isArmyWithinMovementRange(cavalry, 1, 0));
+    assert(!game.gs.isArmyWithinMovementRange(cavalry, 2, 0));
+    assert(game.gs.isArmyWithinMovementRange(cavalry, 1, 1));
+    std::cout << "testArmyEnemyTerritory passed." << std::endl;
+}
+
+int main() {
+    testMovementRangeOpenField();
+    testMovementRangeObstacles();
+    testMovementRangeEmpty();
+    testArmySpeed();
+    testArmyTerrain();
+    testArmyBlocking();
+    testArmyEnemyTerritory();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
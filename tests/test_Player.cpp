@@ -5,19 +5,19 @@
 
 void testPlayerConstructor() {
     Resources initialResources(200, 300, 50, 20);
-    Player player(sf::Color::Red, 1, initialResources);
+    Player player(Color::Red, 1, initialResources);
 
     assert(player.getResources().food == 200);
     assert(player.getResources().wood == 300);
     assert(player.getResources().gold == 50);
     assert(player.getResources().stone == 20);
-    assert(player.getColor() == sf::Color::Red);
+    assert(player.getColor() == Color::Red);
     assert(player.getID() >= 0);
     std::cout << "testPlayerConstructor passed.\n";
 }
 
 void testModifyResources() {
-    Player player(sf::Color::Blue, 2);
+    Player player(Color::Blue, 2);
 
     player.modifyResources(Resources(50, 50, 10, 5));
     assert(player.getResources().food == 150);
@@ -35,14 +35,14 @@ void testModifyResources() {
 }
 
 void testPlayerColor() {
-    Player player(sf::Color::Green, 3);
-    assert(player.getColor() == sf::Color::Green);
+    Player player(Color::Green, 3);
+    assert(player.getColor() == Color::Green);
     std::cout << "testPlayerColor passed.\n";
 }
 
 void testPlayerID() {
-    Player player1(sf::Color::Yellow, 1);
-    Player player2(sf::Color::Red, 2);
+    Player player1(Color::Yellow, 1);
+    Player player2(Color::Red, 2);
 
     assert(player1.getID() != player2.getID());
     assert(player1.getID() < player2.getID());
@@ -50,11 +50,22 @@ void testPlayerID() {
     std::cout << "testPlayerID passed.\n";
 }
 
+void testPlayerIndex() {
+    Player player(Color::Blue, 1);
+    assert(player.getIndex() == NO_PLAYER);
+
+    player.setIndex(3);
+    assert(player.getIndex() == 3);
+
+    std::cout << "testPlayerIndex passed.\n";
+}
+
 int main() {
     testPlayerConstructor();
     testModifyResources();
     testPlayerColor();
     testPlayerID();
+    testPlayerIndex();
 
     std::cout << "All tests passed.\n";
     return 0;
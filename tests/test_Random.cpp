@@ -0,0 +1,90 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "gamestate.hpp"
+#include "random.hpp"
+
+void testRandomReferenceSequence() {
+    // Output of the PCG32 reference implementation for seed 42, stream 54
+    Random random(42, 54);
+    assert(random.next() == 0xa15c02b7u);
+    assert(random.next() == 0x7b47f409u);
+    assert(random.next() == 0xba1d3330u);
+    assert(random.next() == 0x83d2f293u);
+    std::cout << "testRandomReferenceSequence passed." << std::endl;
+}
+
+void testRandomSeed() {
+    Random a(7);
+    Random b(7);
+    for (int i = 0; i < 100; i++) assert(a.next() == b.next());
+
+    // Reseeding restarts the sequence
+    uint32_t first = Random(7).next();
+    a.seed(7);
+    assert(a.next() == first);
+    std::cout << "testRandomSeed passed." << std::endl;
+}
+
+void testRandomStreams() {
+    Random a(7, 0);
+    Random b(7, 1);
+    int same = 0;
+    for (int i = 0; i < 100; i++) same += a.next() == b.next();
+    assert(same < 5);
+    std::cout << "testRandomStreams passed." << std::endl;
+}
+
+void testRandomNextInt() {
+    Random random(1);
+    std::vector<int> counts(6, 0);
+    for (int i = 0; i < 6000; i++) {
+        int value = random.nextInt(6);
+        assert(value >= 0 && value < 6);
+        counts[value]++;
+    }
+    for (int count : counts) assert(count > 800 && count < 1200);
+
+    for (int i = 0; i < 100; i++) assert(random.nextInt(1) == 0);
+    std::cout << "testRandomNextInt passed." << std::endl;
+}
+
+void testGameStateStreams() {
+    GameState a;
+    GameState b;
+    a.addPlayer(std::make_shared<Player>(Color::Red, 1));
+    a.addPlayer(std::make_shared<Player>(Color::Blue, 2));
+    b.addPlayer(std::make_shared<Player>(Color::Red, 1));
+    b.addPlayer(std::make_shared<Player>(Color::Blue, 2));
+    a.setSeed(123);
+    b.setSeed(123);
+    assert(a.getSeed() == 123);
+
+    // Drawing for one player does not change the stream of the other
+    a.getRandom(0).next();
+    assert(a.getRandom(1).next() == b.getRandom(1).next());
+    b.getRandom(0).next();
+    assert(a.getRandom(0).next() == b.getRandom(0).next());
+
+    bool thrown = false;
+    try {
+        a.getRandom(2);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testGameStateStreams passed." << std::endl;
+}
+
+int main() {
+    testRandomReferenceSequence();
+    testRandomSeed();
+    testRandomStreams();
+    testRandomNextInt();
+    testGameStateStreams();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
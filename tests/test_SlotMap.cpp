@@ -0,0 +1,104 @@
+#include <cassert>
+#include <iostream>
+
+#include "slotmap.hpp"
+
+void testSlotMapInsertGet() {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(1);
+    SlotHandle b = map.insert(2);
+
+    assert(map.size() == 2);
+    assert(*map.get(a) == 1);
+    assert(*map.get(b) == 2);
+    assert(a != b);
+    std::cout << "testSlotMapInsertGet passed." << std::endl;
+}
+
+void testSlotMapErase() {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(1);
+    SlotHandle b = map.insert(2);
+    SlotHandle c = map.insert(3);
+
+    // Erasing from the middle keeps the other handles valid
+    assert(map.erase(a));
+    assert(map.size() == 2);
+    assert(map.get(a) == nullptr);
+    assert(*map.get(b) == 2);
+    assert(*map.get(c) == 3);
+
+    // Erasing twice is a no-op
+    assert(!map.erase(a));
+    assert(map.size() == 2);
+    std::cout << "testSlotMapErase passed." << std::endl;
+}
+
+void testSlotMapStaleHandle() {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(1);
+    map.erase(a);
+
+    // The slot gets reused, the old handle must not see the new element
+    SlotHandle b = map.insert(2);
+    assert(b.slot == a.slot);
+    assert(!map.contains(a));
+    assert(map.get(a) == nullptr);
+    assert(*map.get(b) == 2);
+
+    assert(!map.contains(SlotHandle()));
+    std::cout << "testSlotMapStaleHandle passed." << std::endl;
+}
+
+void testSlotMapDenseIteration() {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(1);
+    map.insert(2);
+    map.insert(3);
+    map.erase(a);
+
+    int sum = 0;
+    for (int value : map) sum += value;
+    assert(sum == 5);
+
+    for (int i = 0; i < map.size(); i++) {
+        assert(*map.get(map.handleAt(i)) == map[i]);
+    }
+
+    map.clear();
+    assert(map.empty());
+    std::cout << "testSlotMapDenseIteration passed." << std::endl;
+}
+
+void testSlotMapRestore() {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(1);
+    SlotHandle b = map.insert(2);
+    map.erase(a);
+
+    // An erased element comes back under its old handle
+    assert(!map.restore(b, 3));
+    assert(map.restore(a, 1));
+    assert(*map.get(a) == 1);
+    assert(*map.get(b) == 2);
+    assert(!map.restore(a, 1));
+
+    // Not once its slot has been reused
+    map.erase(a);
+    SlotHandle c = map.insert(4);
+    assert(c.slot == a.slot);
+    assert(!map.restore(a, 1));
+    assert(*map.get(c) == 4);
+    std::cout << "testSlotMapRestore passed." << std::endl;
+}
+
+int main() {
+    testSlotMapInsertGet();
+    testSlotMapErase();
+    testSlotMapStaleHandle();
+    testSlotMapDenseIteration();
+    testSlotMapRestore();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,216 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gamestate.hpp"
+#include "playerAI.hpp"
+#include "snapshot.hpp"
+
+void testSnapshotValues() {
+    SnapshotWriter writer;
+    writer.writeU8(7);
+    writer.writeU32(0xdeadbeef);
+    writer.writeI32(-5);
+    writer.writeU64(0x0123456789abcdefULL);
+    const uint8_t bytes[3] = {1, 2, 3};
+    writer.writeBytes(bytes, 3);
+    assert(writer.getData().size() == 1 + 4 + 4 + 8 + 3);
+    // Little-endian
+    assert(writer.getData()[1] == 0xef);
+
+    SnapshotReader reader(writer.getData());
+    assert(reader.readU8() == 7);
+    assert(reader.readU32() == 0xdeadbeef);
+    assert(reader.readI32() == -5);
+    assert(reader.readU64() == 0x0123456789abcdefULL);
+    SnapshotReader block = reader.readBlock(3);
+    assert(reader.atEnd());
+    assert(block.readBytes(3)[2] == 3);
+    assert(block.atEnd());
+
+    bool thrown = false;
+    try {
+        reader.readU8();
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testSnapshotValues passed." << std::endl;
+}
+
+// Two AI players on a small map with a lake, set up like selfplay does
+struct Match {
+    std::shared_ptr<GameState> gs = std::make_shared<GameState>();
+    std::shared_ptr<PlayerAI> p1;
+    std::shared_ptr<PlayerAI> p2;
+
+    Match() {
+        gs->setSeed(7);
+        p1 = std::make_shared<PlayerAI>(Color::Red, 1, gs);
+        p2 = std::make_shared<PlayerAI>(Color::Blue, 2, gs);
+        for (const std::shared_ptr<PlayerAI>& p : {p1, p2}) {
+            p->addSharedPtr(p);
+            p->setTurnDelay(std::chrono::milliseconds(0));
+            gs->addPlayer(p);
+        }
+        std::string map;
+        for (int x = 0; x < 12; x++) {
+            map += x == 5 || x == 6 ? "GGGGWWWWGGGG" : "GGGGGGGGGGGG";
+        }
+        gs->loadMapFromString(map, 12);
+        gs->claimTile(2, 2, p1);
+        gs->claimTile(9, 9, p2);
+        gs->addTownhall(TownHall(1, 1, p1->getIndex(), 2, 2));
+        gs->addTownhall(TownHall(2, 1, p2->getIndex(), 9, 9));
+        gs->setActivePlayerID(p2->getID());
+    }
+
+    std::vector<uint8_t> snapshot() const {
+        SnapshotWriter writer;
+        gs->writeSnapshot(writer);
+        return writer.getData();
+    }
+};
+
+void testSnapshotResume() {
+    Match original;
+    for (int i = 0; i < 20; i++) original.gs->tick();
+    std::vector<uint8_t> checkpoint = original.snapshot();
+    assert(original.gs->getNumCols() == 12);
+
+    // A fresh match restored from the checkpoint is the same match
+    Match resumed;
+    SnapshotReader reader(checkpoint);
+    resumed.gs->readSnapshot(reader);
+    assert(resumed.snapshot() == checkpoint);
+    assert(resumed.gs->getTurn() == original.gs->getTurn());
+    // Player IDs differ between the matches, the active player is the same
+    bool p1Active = original.gs->getActivePlayerID() == original.p1->getID();
+    assert(resumed.gs->getActivePlayerID() ==
+           (p1Active ? resumed.p1 : resumed.p2)->getID());
+    assert(resumed.p1->getResources().wood ==
+           original.p1->getResources().wood);
+
+    // and plays on exactly like the original, AI state and random streams
+    // included
+    for (int i = 0; i < 40; i++) {
+        original.gs->tick();
+        resumed.gs->tick();
+    }
+    assert(resumed.snapshot() == original.snapshot());
+    assert(original.snapshot() != checkpoint);
+    std::cout << "testSnapshotResume passed." << std::endl;
+}
+
+void testSnapshotFile() {
+    Match original;
+    for (int i = 0; i < 10; i++) original.gs->tick();
+    std::string filename =
+        (std::filesystem::temp_directory_path() / "test_Snapshot.s8s")
+            .string();
+    original.gs->saveSnapshot(filename);
+
+    Match resumed;
+    resumed.gs->loadSnapshot(filename);
+    std::remove(filename.c_str());
+    assert(resumed.snapshot() == original.snapshot());
+    assert(resumed.gs->getIncome(resumed.p1).wood ==
+           original.gs->getIncome(original.p1).wood);
+    assert(resumed.gs->getClaimedTileCount(resumed.p2) ==
+           original.gs->getClaimedTileCount(original.p2));
+    std::cout << "testSnapshotFile passed." << std::endl;
+}
+
+void testSnapshotInvalid() {
+    Match match;
+    std::vector<uint8_t> checkpoint = match.snapshot();
+
+    // Other players
+    GameState alone;
+    alone.addPlayer(std::make_shared<Player>(Color::Red, 1));
+    bool thrown = false;
+    try {
+        SnapshotReader reader(checkpoint);
+        alone.readSnapshot(reader);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Truncated, the match stays as it was
+    checkpoint.resize(checkpoint.size() - 1);
+    thrown = false;
+    try {
+        SnapshotReader reader(checkpoint);
+        match.gs->readSnapshot(reader);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(match.gs->getNumCols() == 12);
+    assert(match.gs->getTownhallOwner(2, 2) == match.p1->getIndex());
+
+    // Trailing data
+    checkpoint = match.snapshot();
+    checkpoint.push_back(0);
+    thrown = false;
+    try {
+        SnapshotReader reader(checkpoint);
+        match.gs->readSnapshot(reader);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // The state of the second player is malformed, the first one keeps its
+    // own
+    Match other;
+    other.p1->modifyResources(Resources(0, 1000, 0, 0));
+    std::vector<uint8_t> malformed = other.snapshot();
+    // Magic, version, turn, active player, seed and player count, then per
+    // player its random stream, the length of its state and the state:
+    // resources, alive, action step and the building to place
+    size_t header = 4 + 4 + 4 + 1 + 8 + 4;
+    size_t stateSize = 16 + 1 + 4 + 1 + 8;
+    size_t building = header + 20 + stateSize + 20 + 16 + 1 + 4;
+    assert(malformed[building] < NUM_BUILDING_TYPES);
+    malformed[building] = NUM_BUILDING_TYPES;
+    int wood = match.p1->getResources().wood;
+    thrown = false;
+    try {
+        SnapshotReader reader(malformed);
+        match.gs->readSnapshot(reader);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(match.p1->getResources().wood == wood);
+
+    // Not a snapshot
+    std::vector<uint8_t> garbage = {'M', 'A', 'P', ' ', 1, 0, 0, 0};
+    thrown = false;
+    try {
+        SnapshotReader reader(garbage);
+        match.gs->readSnapshot(reader);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testSnapshotInvalid passed." << std::endl;
+}
+
+int main() {
+    testSnapshotValues();
+    testSnapshotResume();
+    testSnapshotFile();
+    testSnapshotInvalid();
+
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -23,10 +23,10 @@ void testTileType() {
 
 void testTileOwner() {
     Tile tile(0, 0);
-    assert(tile.getOwner() == nullptr);
-    std::shared_ptr<Player> playerPtr = std::make_shared<Player>(sf::Color(0,128,128), 1);
-    tile.setOwner(playerPtr);
-    assert(tile.getOwner() == playerPtr);
+    assert(tile.getOwner() == NO_PLAYER);
+    PlayerIndex previousOwner = tile.setOwner(1);
+    assert(previousOwner == NO_PLAYER);
+    assert(tile.getOwner() == 1);
     std::cout << "testTileOwner passed.\n";
 }
 
@@ -5,7 +5,7 @@
 #include "townhall.hpp"
 
 void testTownHallConstructor() {
-    auto player = std::make_shared<Player>(sf::Color::Blue, 1);
+    PlayerIndex player = 0;
     TownHall townHall(1, 100, player, 5, 10);
 
     assert(townHall.getId() == 1);
@@ -19,7 +19,7 @@ void testTownHallConstructor() {
 }
 
 void testTownHallGetInfo() {
-    auto player = std::make_shared<Player>(sf::Color::Red, 2);
+    PlayerIndex player = 1;
     TownHall townHall(2, 150, player, 7, 14);
 
     auto info = townHall.getInfo();
@@ -32,7 +32,7 @@ void testTownHallGetInfo() {
 }
 
 void testCanRecruitSoldier() {
-    auto player = std::make_shared<Player>(sf::Color::Green, 3);
+    PlayerIndex player = 2;
     TownHall townHall(3, 120, player, 10, 20);
 
     Resources sufficientResources{15, 0, 0, 0};
@@ -47,7 +47,7 @@ void testCanRecruitSoldier() {
 }
 
 void testTownHallPosition() {
-    auto player = std::make_shared<Player>(sf::Color::Yellow, 4);
+    PlayerIndex player = 3;
     TownHall townHall(4, 200, player, 15, 25);
 
     auto position = townHall.getPosition();
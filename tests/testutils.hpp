@@ -0,0 +1,54 @@
+#ifndef TESTS_TESTUTILS_HPP_
+#define TESTS_TESTUTILS_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gamestate.hpp"
+
+// Everything a replay has to reproduce and an undo has to restore: the turn,
+// resources, income, land, vision and what is on every tile
+inline std::string describe(GameState& gs) {
+    std::ostringstream out;
+    out << "turn " << gs.getTurn() << "\n";
+    for (int i = 0; gs.getPlayer(i); i++) {
+        const std::shared_ptr<Player>& player = gs.getPlayer(i);
+        Resources r = player->getResources();
+        Resources income = gs.getIncome(player);
+        out << r.food << " " << r.wood << " " << r.gold << " " << r.stone
+            << " " << income.food << " " << income.wood << " "
+            << income.gold << " " << income.stone << " "
+            << player->getIsAlive() << " " << gs.getClaimedTileCount(player)
+            << " " << gs.getVisibleXY(player).size() << "\n";
+    }
+    for (int x = 0; x < gs.getNumCols(); x++) {
+        for (int y = 0; y < gs.getNumRows(); y++) {
+            out << int(gs.getTileOwner(x, y));
+            if (gs.tileHasArmy(x, y)) {
+                Army& army = gs.getArmyByLocation(x, y);
+                out << "a" << army.getType() << int(army.getOwner()) << "x"
+                    << army.getUnitCount() << army.getHasCompletedTurn();
+            }
+            if (gs.tileHasBuilding(x, y)) out << "b";
+            out << ",";
+        }
+    }
+    return out.str();
+}
+
+// Builds a terrain layer from columns of 'G', 'W' and 'R' characters
+inline std::vector<uint8_t> makeTerrain(
+    const std::vector<std::string>& columns) {
+    std::vector<uint8_t> terrain;
+    for (const std::string& column : columns) {
+        for (char c : column) {
+            terrain.push_back(c == 'W' ? WATER : c == 'R' ? ROCK : GRASS);
+        }
+    }
+    return terrain;
+}
+
+#endif  // TESTS_TESTUTILS_HPP_